@@ -8,7 +8,15 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogAsyncMixin, Log, All);
 
-TMap<FAsyncMixin*, TSharedRef<FAsyncMixin::FLoadingState>> FAsyncMixin::Loading;
+namespace AsyncMixinCVars
+{
+	static bool bBatchLoads = true;
+	static FAutoConsoleVariableRef CVarBatchLoads(
+		TEXT("AsyncMixin.BatchLoads"),
+		bBatchLoads,
+		TEXT("Combine all of the AsyncLoad requests an FAsyncMixin makes before it starts loading into a single streamable request"),
+		ECVF_Default);
+}
 
 FAsyncMixin::FAsyncMixin()
 {
@@ -20,32 +28,33 @@ FAsyncMixin::~FAsyncMixin()
 
 	// Removing the loading state will cancel any pending loadings it was 
 	// monitoring, and shouldn't receive any future callbacks for completion.
-	Loading.Remove(this);
+	LoadingState.Reset();
 }
 
 const FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingStateConst() const
 {
 	check(IsInGameThread());
-	return Loading.FindChecked(this).Get();
+	check(LoadingState.IsValid());
+	return *LoadingState;
 }
 
 FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingState()
 {
 	check(IsInGameThread());
 
-	if (TSharedRef<FLoadingState>* LoadingState = Loading.Find(this))
+	if (!LoadingState.IsValid())
 	{
-		return (*LoadingState).Get();
+		LoadingState = MakeShared<FLoadingState>(*this);
 	}
 
-	return Loading.Add(this, MakeShared<FLoadingState>(*this)).Get();
+	return *LoadingState;
 }
 
 bool FAsyncMixin::HasLoadingState() const
 {
 	check(IsInGameThread());
 
-	return Loading.Contains(this);
+	return LoadingState.IsValid();
 }
 
 void FAsyncMixin::CancelAsyncLoading()
@@ -156,6 +165,9 @@ void FAsyncMixin::FLoadingState::CancelOnly(bool bDestroying)
 	// There was an issue where the Step would get corrupted because we were calling Reset() on the array.
 	AsyncStepsPendingDestruction = MoveTemp(AsyncSteps);
 
+	// The canceled steps were the only ones referencing the batch, anything queued after this starts a new one.
+	PendingBatch.Reset();
+
 	bPreloadedBundles = false;
 	bHasStarted = false;
 	CurrentAsyncStep = 0;
@@ -191,7 +203,7 @@ void FAsyncMixin::FLoadingState::RequestDestroyThisMemory()
 
 		DestroyMemoryDelegate = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime) {
 			// Remove any memory we were using.
-			FAsyncMixin::Loading.Remove(&OwnerRef);
+			OwnerRef.LoadingState.Reset();
 			return false;
 		}));
 	}
@@ -213,6 +225,9 @@ void FAsyncMixin::FLoadingState::Start()
 	// Cancel any pending kickoff load requests.
 	CancelStartTimer();
 
+	// Everything requested up to now goes out as a single load.
+	FlushPendingBatch();
+
 	bool bStartingStepFound = false;
 
 	if (!bHasStarted)
@@ -228,30 +243,85 @@ void FAsyncMixin::FLoadingState::AsyncLoad(FSoftObjectPath SoftObjectPath, const
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncLoad '%s'"), this, *SoftObjectPath.ToString());
 
-	AsyncSteps.Add(
-		MakeUnique<FAsyncStep>(
-			DelegateToCall,
-			UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"))
-			)
-	);
-
-	TryScheduleStart();
+	AddLoadStep(TArray<FSoftObjectPath>{ SoftObjectPath }, DelegateToCall);
 }
 
 void FAsyncMixin::FLoadingState::AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncLoad [%s]"), this, *FString::JoinBy(SoftObjectPaths, TEXT(", "), [](const FSoftObjectPath& SoftObjectPath) { return FString::Printf(TEXT("'%s'"), *SoftObjectPath.ToString()); }));
 
-	AsyncSteps.Add(
-		MakeUnique<FAsyncStep>(
-			DelegateToCall,
-			UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"))
-			)
-	);
+	AddLoadStep(SoftObjectPaths, DelegateToCall);
+}
+
+void FAsyncMixin::FLoadingState::AddLoadStep(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
+{
+	if (!AsyncMixinCVars::bBatchLoads)
+	{
+		AsyncSteps.Add(
+			MakeUnique<FAsyncStep>(
+				DelegateToCall,
+				UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"))
+				)
+		);
+
+		TryScheduleStart();
+		return;
+	}
+
+	// Anything already in memory doesn't need to wait on the batch, so its callback isn't held up by the slowest load.
+	TArray<FSoftObjectPath, TInlineAllocator<4>> PathsToLoad;
+	for (const FSoftObjectPath& SoftObjectPath : SoftObjectPaths)
+	{
+		if (SoftObjectPath.IsNull())
+		{
+			continue;
+		}
+
+		const UObject* ExistingObject = SoftObjectPath.ResolveObject();
+		if (!ExistingObject || ExistingObject->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
+		{
+			PathsToLoad.Add(SoftObjectPath);
+		}
+	}
+
+	if (PathsToLoad.Num() == 0)
+	{
+		AsyncSteps.Add(MakeUnique<FAsyncStep>(DelegateToCall));
+	}
+	else
+	{
+		if (!PendingBatch.IsValid())
+		{
+			PendingBatch = MakeShared<FLoadBatch>();
+		}
+
+		for (const FSoftObjectPath& SoftObjectPath : PathsToLoad)
+		{
+			PendingBatch->Paths.AddUnique(SoftObjectPath);
+		}
+
+		AsyncSteps.Add(MakeUnique<FAsyncStep>(DelegateToCall, PendingBatch));
+	}
 
 	TryScheduleStart();
 }
 
+void FAsyncMixin::FLoadingState::FlushPendingBatch()
+{
+	if (!PendingBatch.IsValid())
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FAsyncMixin_FLoadingState_FlushPendingBatch);
+	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Requesting %d paths in one batch"), this, PendingBatch->Paths.Num());
+
+	// Steps hold on to the batch, so we can forget about it and let the next AsyncLoad start a new one.
+	TSharedPtr<FLoadBatch> Batch = MoveTemp(PendingBatch);
+	Batch->StreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Batch->Paths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"));
+	Batch->bRequested = true;
+}
+
 void FAsyncMixin::FLoadingState::AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X]  AsyncPreload Assets [%s], Bundles[%s]"),
@@ -352,6 +422,10 @@ void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
 
 	while (CurrentAsyncStep < AsyncSteps.Num())
 	{
+		// A user callback (including one called earlier in this loop) may have queued more loads
+		// without starting them again, and the steps of a batch can't be waited on until it's requested.
+		FlushPendingBatch();
+
 		FAsyncStep* Step = AsyncSteps[CurrentAsyncStep].Get();
 		if (Step->IsLoadingInProgress())
 		{
@@ -443,6 +517,12 @@ FAsyncMixin::FLoadingState::FAsyncStep::FAsyncStep(const FSimpleDelegate& InUser
 {
 }
 
+FAsyncMixin::FLoadingState::FAsyncStep::FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FLoadBatch>& InBatch)
+	: UserCallback(InUserCallback)
+	, Batch(InBatch)
+{
+}
+
 FAsyncMixin::FLoadingState::FAsyncStep::~FAsyncStep()
 {
 
@@ -464,6 +544,16 @@ bool FAsyncMixin::FLoadingState::FAsyncStep::IsComplete() const
 	{
 		return Condition->IsComplete();
 	}
+	else if (Batch.IsValid())
+	{
+		if (!Batch->bRequested)
+		{
+			return false;
+		}
+
+		// No handle means nothing in the batch needed loading.
+		return !Batch->StreamingHandle.IsValid() || Batch->StreamingHandle->HasLoadCompleted();
+	}
 
 	return true;
 }
@@ -479,6 +569,15 @@ void FAsyncMixin::FLoadingState::FAsyncStep::Cancel()
 	{
 		Condition.Reset();
 	}
+	else if (Batch.IsValid())
+	{
+		// Shared with the other steps of the batch, which are all being canceled along with this one.
+		if (Batch->StreamingHandle.IsValid())
+		{
+			Batch->StreamingHandle->BindCompleteDelegate(FSimpleDelegate());
+		}
+		Batch.Reset();
+	}
 
 	bIsCompletionDelegateBound = false;
 }
@@ -499,6 +598,15 @@ bool FAsyncMixin::FLoadingState::FAsyncStep::BindCompleteDelegate(const FSimpleD
 	{
 		Condition->BindCompleteDelegate(NewDelegate);
 	}
+	else if (Batch.IsValid())
+	{
+		// Every step of a batch binds the same delegate, so rebinding for the next step is harmless.
+		if (!ensure(Batch->StreamingHandle.IsValid()))
+		{
+			return false;
+		}
+		Batch->StreamingHandle->BindCompleteDelegate(NewDelegate);
+	}
 
 	bIsCompletionDelegateBound = true;
 
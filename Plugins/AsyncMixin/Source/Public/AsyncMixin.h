@@ -60,10 +60,14 @@ DECLARE_DELEGATE_OneParam(FStreamableHandleDelegate, TSharedPtr<FStreamableHandl
  * NOTE: The FAsyncMixin also makes it safe to pass [this] as a captured input into your lambda, because it handles 
  * unhooking everything if either your owner class is destroyed, or you cancel everything.
  *
- * NOTE: FAsyncMixin doesn't add any additional memory to your class.  Several classes currently handling async loading 
+ * NOTE: FAsyncMixin only adds a single pointer to your class.  Several classes currently handling async loading 
  * internally allocate TSharedPtr<FStreamableHandle> members and tend to hold onto SoftObjectPaths temporary state.  The 
- * FAsyncMixin does all of this internally with a static TMap so that all of the async request memory is stored temporarily
- * and sparsely.
+ * FAsyncMixin allocates all of this on demand and frees it once loading is done, so the async request memory is still
+ * stored temporarily and sparsely, without having to look it up in a global map on every step.
+ *
+ * NOTE: All of the AsyncLoad requests made before loading starts (usually the same frame) are combined into a single
+ * streamable request, so a widget asking for dozens of icons only creates one handle.  The callbacks are still called
+ * in request order.  If you just want everything at once, use AsyncLoadAll, which calls you back once with all of them.
  * 
  * NOTE: For debugging and understanding what's going on, you should add -LogCmds="LogAsyncMixin Verbose" to the command line.
  */
@@ -144,6 +148,54 @@ protected:
 	/** Async load an array of FSoftObjectPath, call the Callback when complete. */
 	void AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& Callback = FSimpleDelegate());
 
+	/** Async load all of the TSoftObjectPtr<T> together, call the Callback once with all of them (in the same order) when complete. */
+	template<typename T = UObject>
+	void AsyncLoadAll(const TArray<TSoftObjectPtr<T>>& SoftObjects, TFunction<void(const TArray<T*>&)>&& Callback)
+	{
+		TArray<FSoftObjectPath> SoftObjectPaths;
+		SoftObjectPaths.Reserve(SoftObjects.Num());
+		for (const TSoftObjectPtr<T>& SoftObject : SoftObjects)
+		{
+			SoftObjectPaths.Add(SoftObject.ToSoftObjectPath());
+		}
+
+		AsyncLoad(SoftObjectPaths,
+			FSimpleDelegate::CreateLambda([SoftObjects, UserCallback = MoveTemp(Callback)]() mutable {
+				TArray<T*> LoadedObjects;
+				LoadedObjects.Reserve(SoftObjects.Num());
+				for (const TSoftObjectPtr<T>& SoftObject : SoftObjects)
+				{
+					LoadedObjects.Add(SoftObject.Get());
+				}
+				UserCallback(LoadedObjects);
+			})
+		);
+	}
+
+	/** Async load all of the TSoftClassPtr<T> together, call the Callback once with all of them (in the same order) when complete. */
+	template<typename T = UObject>
+	void AsyncLoadAll(const TArray<TSoftClassPtr<T>>& SoftClasses, TFunction<void(const TArray<TSubclassOf<T>>&)>&& Callback)
+	{
+		TArray<FSoftObjectPath> SoftObjectPaths;
+		SoftObjectPaths.Reserve(SoftClasses.Num());
+		for (const TSoftClassPtr<T>& SoftClass : SoftClasses)
+		{
+			SoftObjectPaths.Add(SoftClass.ToSoftObjectPath());
+		}
+
+		AsyncLoad(SoftObjectPaths,
+			FSimpleDelegate::CreateLambda([SoftClasses, UserCallback = MoveTemp(Callback)]() mutable {
+				TArray<TSubclassOf<T>> LoadedClasses;
+				LoadedClasses.Reserve(SoftClasses.Num());
+				for (const TSoftClassPtr<T>& SoftClass : SoftClasses)
+				{
+					LoadedClasses.Add(SoftClass.Get());
+				}
+				UserCallback(LoadedClasses);
+			})
+		);
+	}
+
 	/** Given an array of primary assets, it loads all of the bundles referenced by properties of these assets specified in the LoadBundles array. */
 	template<typename T = UPrimaryDataAsset>
 	void AsyncPreloadPrimaryAssetsAndBundles(const TArray<T*>& Assets, const TArray<FName>& LoadBundles, const FSimpleDelegate& Callback = FSimpleDelegate())
@@ -197,8 +249,8 @@ protected:
 
 private:
 	/**
-	 * The FLoadingState is what actually is allocated for the FAsyncMixin in a big map so that the FAsyncMixin itself holds no
-	 * no memory, and we dynamically create the FLoadingState only if needed, and destroy it when it's unneeded.
+	 * The FLoadingState is what actually is allocated for the FAsyncMixin so that the FAsyncMixin itself only holds a pointer,
+	 * and we dynamically create the FLoadingState only if needed, and destroy it when it's unneeded.
 	 */
 	class FLoadingState : public TSharedFromThis<FLoadingState>
 	{
@@ -224,6 +276,17 @@ private:
 		bool IsPendingDestroy() const;
 
 	private:
+		/** Soft object paths requested since the last flush, loaded with a single streamable request. */
+		struct FLoadBatch
+		{
+			TArray<FSoftObjectPath> Paths;
+			TSharedPtr<FStreamableHandle> StreamingHandle;
+			bool bRequested = false;
+		};
+
+		void AddLoadStep(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall);
+		void FlushPendingBatch();
+
 		void CancelOnly(bool bDestroying);
 		void CancelStartTimer();
 		void TryScheduleStart();
@@ -249,6 +312,7 @@ private:
 			FAsyncStep(const FSimpleDelegate& InUserCallback);
 			FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FStreamableHandle>& InStreamingHandle);
 			FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FAsyncCondition>& InCondition);
+			FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FLoadBatch>& InBatch);
 
 			~FAsyncStep();
 
@@ -272,6 +336,7 @@ private:
 			// Possible Async 'thing'
 			TSharedPtr<FStreamableHandle> StreamingHandle;
 			TSharedPtr<FAsyncCondition> Condition;
+			TSharedPtr<FLoadBatch> Batch;
 		};
 
 		bool bHasStarted = false;
@@ -280,6 +345,9 @@ private:
 		TArray<TUniquePtr<FAsyncStep>> AsyncSteps;
 		TArray<TUniquePtr<FAsyncStep>> AsyncStepsPendingDestruction;
 
+		/** The batch new AsyncLoad steps are added to, until it is flushed when loading starts. */
+		TSharedPtr<FLoadBatch> PendingBatch;
+
 		FTSTicker::FDelegateHandle StartTimerDelegate;
 		FTSTicker::FDelegateHandle DestroyMemoryDelegate;
 	};
@@ -293,7 +361,7 @@ private:
 	bool IsLoadingInProgressOrPending() const;
 
 private:
-	static TMap<FAsyncMixin*, TSharedRef<FLoadingState>> Loading;
+	TSharedPtr<FLoadingState> LoadingState;
 };
 
 /**
@@ -308,6 +376,8 @@ class ASYNCMIXIN_API FAsyncScope : public FAsyncMixin
 public:
 	using FAsyncMixin::AsyncLoad;
 
+	using FAsyncMixin::AsyncLoadAll;
+
 	using FAsyncMixin::AsyncPreloadPrimaryAssetsAndBundles;
 
 	using FAsyncMixin::AsyncCondition;
@@ -57,6 +57,12 @@ public class MyShooterFeaturePluginRuntime : ModuleRules
 				"CommonLoadingScreen",
 				// FShaderPipelineCache::NumPrecompilesRemaining() (MYSTLevelLoadingSubsystem)
 				"RenderCore",
+				// IAssetRegistry package sizes + UGameFeaturesSubsystemSettings bundle
+				// names for the travel preload (MYSTLevelLoadingSubsystem)
+				"AssetRegistry",
+				"GameFeatures",
+				// FJsonObject / FJsonSerializer for load reports (MYSTLevelLoadRecorder)
+				"Json",
 				// IMoviePlayer + FLoadingScreenAttributes — keeps Slate ticking during
 				// the synchronous LoadMap/FlushAsyncLoading block (MYSTLevelLoadingSubsystem)
 				"MoviePlayer",
@@ -8,6 +8,7 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Character/LyraHealthComponent.h"
+#include "Character/LyraHealthEventSubsystem.h"
 #include "GameFramework/Pawn.h"
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -86,8 +87,7 @@ void UBTService_AIStateObserver::OnBecomeRelevant(UBehaviorTreeComponent& OwnerC
 		{
 			if (ULyraHealthComponent* HealthComp = ULyraHealthComponent::FindHealthComponent(Pawn))
 			{
-				TrackedHealthComp = HealthComp;
-				HealthComp->OnHealthChanged.AddDynamic(this, &UBTService_AIStateObserver::OnAIHealthChanged);
+				BindHealthEvents(HealthComp);
 			}
 		}
 	}
@@ -111,16 +111,28 @@ void UBTService_AIStateObserver::BeginDestroy()
 	// where GC collects the node instance before the BT shuts down cleanly
 	// (e.g. a sudden actor destroy during PIE stop or a level transition that
 	// bypasses the normal BT stop sequence).  Without this, the health
-	// component's OnHealthChanged multicast would retain a dangling binding.
+	// health event subsystem would keep a consumer entry for a dead node.
 	UnbindHealthDelegate();
 
 	Super::BeginDestroy();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Health delegate callback  (fires immediately when damage lands)
+// Health events  (end of the frame the damage lands in)
 // ─────────────────────────────────────────────────────────────────────────────
 
+void UBTService_AIStateObserver::HandleHealthEvents(TConstArrayView<FLyraHealthEvent> Events)
+{
+	// Only the tracked component's events, see BindHealthEvents
+	for (const FLyraHealthEvent& Event : Events)
+	{
+		if (Event.Type == ELyraHealthEventType::HealthChanged)
+		{
+			OnAIHealthChanged(Event.HealthComponent, Event.OldValue, Event.NewValue, Event.Instigator);
+		}
+	}
+}
+
 void UBTService_AIStateObserver::OnAIHealthChanged(
 	ULyraHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* /*Instigator*/)
 {
@@ -166,12 +178,30 @@ void UBTService_AIStateObserver::OnAIHealthChanged(
 // Helper
 // ─────────────────────────────────────────────────────────────────────────────
 
+void UBTService_AIStateObserver::BindHealthEvents(ULyraHealthComponent* HealthComp)
+{
+	UnbindHealthDelegate();
+
+	TrackedHealthComp = HealthComp;
+
+	// The stream also carries changes from health components that don't broadcast OnHealthChanged
+	if (ULyraHealthEventSubsystem* HealthEvents = UWorld::GetSubsystem<ULyraHealthEventSubsystem>(HealthComp->GetWorld()))
+	{
+		HealthEventsHandle = HealthEvents->AddComponentEventsConsumer(HealthComp,
+			FLyraHealthEventBatchDelegate::FDelegate::CreateUObject(this, &UBTService_AIStateObserver::HandleHealthEvents));
+	}
+}
+
 void UBTService_AIStateObserver::UnbindHealthDelegate()
 {
 	if (ULyraHealthComponent* HealthComp = TrackedHealthComp.Get())
 	{
-		HealthComp->OnHealthChanged.RemoveDynamic(this, &UBTService_AIStateObserver::OnAIHealthChanged);
+		if (ULyraHealthEventSubsystem* HealthEvents = UWorld::GetSubsystem<ULyraHealthEventSubsystem>(HealthComp->GetWorld()))
+		{
+			HealthEvents->RemoveComponentEventsConsumer(HealthComp, HealthEventsHandle);
+		}
 	}
+	HealthEventsHandle.Reset();
 	TrackedHealthComp = nullptr;
 }
 
@@ -213,8 +243,7 @@ void UBTService_AIStateObserver::TickNode(UBehaviorTreeComponent& OwnerComp, uin
 	{
 		if (ULyraHealthComponent* HealthComp = ULyraHealthComponent::FindHealthComponent(AIPawn))
 		{
-			TrackedHealthComp = HealthComp;
-			HealthComp->OnHealthChanged.AddDynamic(this, &UBTService_AIStateObserver::OnAIHealthChanged);
+			BindHealthEvents(HealthComp);
 		}
 	}
 
@@ -236,7 +265,7 @@ void UBTService_AIStateObserver::TickNode(UBehaviorTreeComponent& OwnerComp, uin
 
 	// ─── 2. HasTakenDamageRecently cooldown expiry ────────────────────────────
 	//
-	// Damage arming happens instantly in OnAIHealthChanged (delegate-driven).
+	// Damage arming happens in OnAIHealthChanged (event-driven).
 	// This tick only needs to check whether the cooldown window has elapsed
 	// and clear the flag if so.
 	if (HasTakenDamageRecentlyKey.IsSet() && LastDamageTime >= 0.f)
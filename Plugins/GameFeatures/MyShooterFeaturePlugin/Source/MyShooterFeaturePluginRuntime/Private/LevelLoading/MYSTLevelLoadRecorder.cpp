@@ -0,0 +1,250 @@
+﻿// Copyright MyShooterScenarios. All Rights Reserved.
+
+#include "LevelLoading/MYSTLevelLoadRecorder.h"
+#include "LevelLoading/MYSTLevelLoadingSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/LevelStreaming.h"
+#include "ShaderPipelineCache.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace MYSTLevelLoadRecorder
+{
+	/** PSO samples closer together than this are dropped unless the count changed. */
+	static constexpr double PSOSampleInterval = 0.1;
+}
+
+FMYSTLevelLoadRecorder::~FMYSTLevelLoadRecorder()
+{
+	UnbindGCDelegates();
+}
+
+void FMYSTLevelLoadRecorder::Begin(const FString& InMapPath)
+{
+	UnbindGCDelegates();
+
+	MapPath        = InMapPath;
+	bRecording     = true;
+	StartTime      = FPlatformTime::Seconds();
+	MapLoadedTime  = -1.0;
+	LastSampleTime = StartTime;
+
+	StreamingLevels.Reset();
+	PSOSamples.Reset();
+
+	GCCount     = 0;
+	GCSeconds   = 0.0;
+	GCStartTime = 0.0;
+	AsyncLoadingIdleSeconds = 0.0;
+
+	// LoadMap collects the old world, so this is where most of the GC cost shows up.
+	PreGCHandle  = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FMYSTLevelLoadRecorder::HandlePreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FMYSTLevelLoadRecorder::HandlePostGarbageCollect);
+}
+
+void FMYSTLevelLoadRecorder::MarkMapLoaded(UWorld* World)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	MapLoadedTime = SinceStart(FPlatformTime::Seconds());
+	Sample(World);
+}
+
+void FMYSTLevelLoadRecorder::Sample(UWorld* World)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = SinceStart(Now);
+
+	// ---- Async loader idle ----------------------------------------------
+	// Nothing queued on the async loader while we are still on the loading
+	// screen means the time went somewhere else (GC, game thread, PSOs).
+	if (!IsAsyncLoading())
+	{
+		AsyncLoadingIdleSeconds += Now - LastSampleTime;
+	}
+	LastSampleTime = Now;
+
+	// ---- PSO queue ------------------------------------------------------
+	const int32 Remaining = static_cast<int32>(FShaderPipelineCache::NumPrecompilesRemaining());
+	if (PSOSamples.Num() == 0
+		|| PSOSamples.Last().Remaining != Remaining
+		|| (Elapsed - PSOSamples.Last().Time) >= MYSTLevelLoadRecorder::PSOSampleInterval)
+	{
+		PSOSamples.Add({ Elapsed, Remaining });
+	}
+
+	// ---- Streaming levels -----------------------------------------------
+	if (!World)
+	{
+		return;
+	}
+
+	for (ULevelStreaming* Level : World->GetStreamingLevels())
+	{
+		if (!Level)
+		{
+			continue;
+		}
+
+		const FName PackageName = Level->GetWorldAssetPackageFName();
+		FStreamingLevelRecord* Record = StreamingLevels.FindByPredicate([PackageName](const FStreamingLevelRecord& Existing) { return Existing.PackageName == PackageName; });
+		if (!Record)
+		{
+			Record = &StreamingLevels.AddDefaulted_GetRef();
+			Record->PackageName = PackageName;
+		}
+
+		if (Record->LoadedTime < 0.0 && Level->IsLevelLoaded())
+		{
+			Record->LoadedTime = Elapsed;
+		}
+		if (Record->VisibleTime < 0.0 && Level->IsLevelVisible())
+		{
+			Record->VisibleTime = Elapsed;
+		}
+	}
+}
+
+FString FMYSTLevelLoadRecorder::End(const FMYSTLevelLoadTimings& Timings, bool bWriteReport)
+{
+	if (!bRecording)
+	{
+		return FString();
+	}
+
+	bRecording = false;
+	UnbindGCDelegates();
+
+	if (!bWriteReport)
+	{
+		return FString();
+	}
+
+	// ---- JSON -----------------------------------------------------------
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Map"), MapPath);
+	Root->SetBoolField(TEXT("MapLoadFailed"), Timings.bMapLoadFailed);
+	Root->SetNumberField(TEXT("TotalSeconds"), Timings.TotalSeconds);
+	Root->SetNumberField(TEXT("MapSeconds"), Timings.MapSeconds);
+	Root->SetNumberField(TEXT("StreamingSeconds"), Timings.StreamingSeconds);
+	Root->SetNumberField(TEXT("PSOSeconds"), Timings.PSOSeconds);
+	Root->SetNumberField(TEXT("PreloadSeconds"), Timings.PreloadSeconds);
+	Root->SetNumberField(TEXT("PreloadedPackages"), Timings.PreloadedPackages);
+	Root->SetNumberField(TEXT("PreloadedBytes"), (double)Timings.PreloadedBytes);
+	Root->SetNumberField(TEXT("PSOsAtMapLoad"), Timings.PSOsAtMapLoad);
+	Root->SetNumberField(TEXT("MapLoadedAt"), MapLoadedTime);
+	Root->SetNumberField(TEXT("GCCount"), GCCount);
+	Root->SetNumberField(TEXT("GCSeconds"), GCSeconds);
+	Root->SetNumberField(TEXT("AsyncLoadingIdleSeconds"), AsyncLoadingIdleSeconds);
+
+	TArray<TSharedPtr<FJsonValue>> LevelValues;
+	for (const FStreamingLevelRecord& Record : StreamingLevels)
+	{
+		TSharedRef<FJsonObject> LevelObject = MakeShared<FJsonObject>();
+		LevelObject->SetStringField(TEXT("Package"), Record.PackageName.ToString());
+		LevelObject->SetNumberField(TEXT("LoadedAt"), Record.LoadedTime);
+		LevelObject->SetNumberField(TEXT("VisibleAt"), Record.VisibleTime);
+		LevelValues.Add(MakeShared<FJsonValueObject>(LevelObject));
+	}
+	Root->SetArrayField(TEXT("StreamingLevels"), LevelValues);
+
+	TArray<TSharedPtr<FJsonValue>> PSOValues;
+	for (const FPSOSample& PSOSample : PSOSamples)
+	{
+		TArray<TSharedPtr<FJsonValue>> Pair;
+		Pair.Add(MakeShared<FJsonValueNumber>(PSOSample.Time));
+		Pair.Add(MakeShared<FJsonValueNumber>(PSOSample.Remaining));
+		PSOValues.Add(MakeShared<FJsonValueArray>(Pair));
+	}
+	Root->SetArrayField(TEXT("PSORemaining"), PSOValues);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	// ---- CSV --------------------------------------------------------------
+	// One long table (Section,Name,Time,Value) so it pastes straight into a sheet.
+	// Times are seconds since RequestLevelTravel; -1 means it never happened.
+	FString CsvText = TEXT("Section,Name,Time,Value\n");
+	CsvText += FString::Printf(TEXT("Phase,Map,%.4f,\n"), Timings.MapSeconds);
+	CsvText += FString::Printf(TEXT("Phase,Streaming,%.4f,\n"), Timings.StreamingSeconds);
+	CsvText += FString::Printf(TEXT("Phase,PSO,%.4f,%d\n"), Timings.PSOSeconds, Timings.PSOsAtMapLoad);
+	CsvText += FString::Printf(TEXT("Phase,Preload,%.4f,%lld\n"), Timings.PreloadSeconds, Timings.PreloadedBytes);
+	CsvText += FString::Printf(TEXT("Phase,Total,%.4f,\n"), Timings.TotalSeconds);
+	CsvText += FString::Printf(TEXT("GC,Collections,%.4f,%d\n"), GCSeconds, GCCount);
+	CsvText += FString::Printf(TEXT("AsyncLoading,Idle,%.4f,\n"), AsyncLoadingIdleSeconds);
+	for (const FStreamingLevelRecord& Record : StreamingLevels)
+	{
+		CsvText += FString::Printf(TEXT("StreamingLevelLoaded,%s,%.4f,\n"), *Record.PackageName.ToString(), Record.LoadedTime);
+		CsvText += FString::Printf(TEXT("StreamingLevelVisible,%s,%.4f,\n"), *Record.PackageName.ToString(), Record.VisibleTime);
+	}
+	for (const FPSOSample& PSOSample : PSOSamples)
+	{
+		CsvText += FString::Printf(TEXT("PSORemaining,,%.4f,%d\n"), PSOSample.Time, PSOSample.Remaining);
+	}
+
+	// ---- Write ------------------------------------------------------------
+	FString MapName = MapPath;
+	int32 OptionsStart = INDEX_NONE;
+	if (MapName.FindChar(TEXT('?'), OptionsStart))
+	{
+		MapName.LeftInline(OptionsStart);
+	}
+
+	const FString BaseName = FPaths::Combine(FPaths::ProfilingDir(), TEXT("LevelLoads"),
+		FString::Printf(TEXT("%s_%s"), *FPackageName::GetShortName(MapName), *FDateTime::Now().ToString()));
+
+	const FString JsonPath = BaseName + TEXT(".json");
+	if (!FFileHelper::SaveStringToFile(JsonText, *JsonPath) || !FFileHelper::SaveStringToFile(CsvText, *(BaseName + TEXT(".csv"))))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MYSTLevelLoadRecorder: Failed to write load report '%s'."), *BaseName);
+		return FString();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MYSTLevelLoadRecorder: Wrote load report '%s' (GC %d x / %.2f s, async loader idle %.2f s)."),
+		*JsonPath, GCCount, GCSeconds, AsyncLoadingIdleSeconds);
+
+	return JsonPath;
+}
+
+void FMYSTLevelLoadRecorder::HandlePreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void FMYSTLevelLoadRecorder::HandlePostGarbageCollect()
+{
+	if (GCStartTime > 0.0)
+	{
+		++GCCount;
+		GCSeconds += FPlatformTime::Seconds() - GCStartTime;
+		GCStartTime = 0.0;
+	}
+}
+
+void FMYSTLevelLoadRecorder::UnbindGCDelegates()
+{
+	if (PreGCHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+		PreGCHandle.Reset();
+	}
+	if (PostGCHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+		PostGCHandle.Reset();
+	}
+}
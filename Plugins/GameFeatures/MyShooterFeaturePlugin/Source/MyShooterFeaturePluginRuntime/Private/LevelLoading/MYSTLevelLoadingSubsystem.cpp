@@ -7,6 +7,18 @@
 #include "Engine/GameInstance.h"
 #include "Kismet/GameplayStatics.h"
 #include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "GameFeaturesSubsystemSettings.h"
+
+// Lyra experience types — used to resolve what to preload for a map
+#include "GameModes/LyraUserFacingExperienceDefinition.h"
+#include "System/LyraAssetManager.h"
+#include "Misc/App.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/Engine.h"
 
 // UE5 PSO / shader precompile polling
 // FShaderPipelineCache lives in RenderCore
@@ -18,6 +30,35 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MYSTLevelLoadingSubsystem)
 
+namespace MYSTLevelLoading
+{
+	/** WaitingForMap timeout used by the load benchmark when PhaseTimeoutSeconds is 0. */
+	static constexpr float BenchmarkMapTimeoutSeconds = 120.f;
+}
+
+// ---------------------------------------------------------------------------
+// Console
+// ---------------------------------------------------------------------------
+
+static FAutoConsoleCommandWithWorldAndArgs CmdMYSTLevelLoadBenchmark(
+	TEXT("MYST.LevelLoad.Benchmark"),
+	TEXT("MYST.LevelLoad.Benchmark <Iterations> <MaxSecondsPerLoad> <Map> [Map...] — travels between the maps and reports load times. ")
+	TEXT("Exits with code 1 on a regression when run with -unattended or -ExitAfterLevelLoadBenchmark."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UMYSTLevelLoadingSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UMYSTLevelLoadingSubsystem>() : nullptr;
+		if (!Subsystem || Args.Num() < 3)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: MYST.LevelLoad.Benchmark <Iterations> <MaxSecondsPerLoad> <Map> [Map...]"));
+			return;
+		}
+
+		const TArray<FString> Maps(Args.GetData() + 2, Args.Num() - 2);
+		const bool bExitWhenDone = FApp::IsUnattended() || FParse::Param(FCommandLine::Get(), TEXT("ExitAfterLevelLoadBenchmark"));
+		Subsystem->StartLoadBenchmark(Maps, FCString::Atoi(*Args[0]), FCString::Atof(*Args[1]), bExitWhenDone);
+	}));
+
 // ---------------------------------------------------------------------------
 // USubsystem
 // ---------------------------------------------------------------------------
@@ -34,12 +75,25 @@ void UMYSTLevelLoadingSubsystem::Initialize(FSubsystemCollectionBase& Collection
 	// we take over from PostLoadMap to gate streaming + PSO phases.
 	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
 		this, &UMYSTLevelLoadingSubsystem::HandlePostLoadMap);
+
+	// A failed travel never reaches PostLoadMap, end the transition right away
+	// instead of waiting for the WaitingForMap timeout.
+	if (GEngine)
+	{
+		TravelFailureDelegateHandle = GEngine->OnTravelFailure().AddUObject(
+			this, &UMYSTLevelLoadingSubsystem::HandleTravelFailure);
+	}
 }
 
 void UMYSTLevelLoadingSubsystem::Deinitialize()
 {
 	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().Remove(TravelFailureDelegateHandle);
+	}
 	UnregisterFromLoadingManager();
+	ReleaseTargetPreload();
 
 	Super::Deinitialize();
 }
@@ -66,17 +120,23 @@ void UMYSTLevelLoadingSubsystem::Tick(float DeltaTime)
 {
 	const double Now = FPlatformTime::Seconds();
 
+	LoadRecorder.Sample(LoadedWorldRef.Get());
+
 	// ---- WaitingForMap ------------------------------------------------
 	// The ULoadingScreenManager already handles the PreLoadMap→PostLoadMap
 	// window. We just sit here until HandlePostLoadMap() advances us.
 	if (CurrentPhase == EMYSTLevelLoadPhase::WaitingForMap)
 	{
-		// Timeout safety — if PostLoadMap never fires (e.g. travel failed)
-		if (PhaseTimeoutSeconds > 0.f && (Now - PhaseStartTime) > PhaseTimeoutSeconds)
+		// Timeout safety — if PostLoadMap never fires (e.g. travel failed).
+		// A benchmark must always move on, so it falls back to a fixed timeout.
+		const float MapTimeoutSeconds = (PhaseTimeoutSeconds > 0.f) ? PhaseTimeoutSeconds
+			: (BenchmarkMaps.Num() > 0 ? MYSTLevelLoading::BenchmarkMapTimeoutSeconds : 0.f);
+		if (MapTimeoutSeconds > 0.f && (Now - PhaseStartTime) > MapTimeoutSeconds)
 		{
 			UE_LOG(LogTemp, Warning,
 				TEXT("MYSTLevelLoadingSubsystem: WaitingForMap timed out after %.1f s — advancing to Idle."),
-				PhaseTimeoutSeconds);
+				MapTimeoutSeconds);
+			CurrentLoadTimings.bMapLoadFailed = true;
 			AdvanceToIdle();
 		}
 		return;
@@ -97,6 +157,18 @@ void UMYSTLevelLoadingSubsystem::Tick(float DeltaTime)
 			return;
 		}
 
+		// PSO precompilation is already running alongside streaming — note
+		// when it drains so the PSO phase can be skipped straight through.
+		const int32 Remaining = static_cast<int32>(FShaderPipelineCache::NumPrecompilesRemaining());
+		if (Remaining == 0 && !bPSOsDrained)
+		{
+			bPSOsDrained = true;
+			CurrentLoadTimings.PSOSeconds = (float)(Now - MapLoadedTime);
+		}
+
+		const int32 Total = FMath::Max(TotalPSOsAtStart, 1);
+		OnShaderProgressUpdated.Broadcast(1.f - FMath::Clamp((float)Remaining / (float)Total, 0.f, 1.f), Remaining);
+
 		if (World && AreAllStreamingLevelsReady(World))
 		{
 			AdvanceToWaitingForPSO();
@@ -125,6 +197,12 @@ void UMYSTLevelLoadingSubsystem::Tick(float DeltaTime)
 
 		if (Remaining == 0)
 		{
+			if (!bPSOsDrained)
+			{
+				bPSOsDrained = true;
+				CurrentLoadTimings.PSOSeconds = (float)(Now - MapLoadedTime);
+			}
+
 			// Gate cleared — start MinHold timer on first clear tick
 			if (AllGatesClearedTime <= 0.0)
 			{
@@ -195,10 +273,40 @@ void UMYSTLevelLoadingSubsystem::RequestLevelTravel(const FString& MapPath, bool
 	LoadedWorldRef  = nullptr;
 	AllGatesClearedTime = 0.0;
 	TotalPSOsAtStart    = 0;
+	LoadStartTime   = PhaseStartTime;
+	MapLoadedTime   = 0.0;
+	bPSOsDrained    = false;
+
+	CurrentLoadTimings = FMYSTLevelLoadTimings();
+	CurrentLoadTimings.MapPath = MapPath;
+
+#if !UE_BUILD_SHIPPING
+	LoadRecorder.Begin(MapPath);
+#endif
 
 	RegisterWithLoadingManager();
 	OnLoadingStarted.Broadcast();
 
+	// Pipeline: get the target's assets streaming NOW, while the loading screen
+	// fades in and the old world tears down, rather than after LoadMap starts.
+	if (bPreloadTargetAssets)
+	{
+		StartTargetPreload(MapPath);
+	}
+
+	// Let PSO precompilation use the full batch budget while nothing is
+	// rendering gameplay anyway. Restored in ReleaseTargetPreload().
+	if (bFastPSOPrecompileDuringLoad && !bOverridingPSOBatchMode)
+	{
+		// The engine has no getter for the batch mode. ULoadingScreenManager is the one that sets it,
+		// Fast while its screen is up and Background otherwise, so remember which of those we replace.
+		const ULoadingScreenManager* LoadingScreenManager = GetGameInstance()->GetSubsystem<ULoadingScreenManager>();
+		bLoadingScreenShownWhenOverridingPSOBatchMode = LoadingScreenManager && LoadingScreenManager->GetLoadingScreenDisplayStatus();
+		bOverridingPSOBatchMode = true;
+
+		FShaderPipelineCache::SetBatchMode(FShaderPipelineCache::BatchMode::Fast);
+	}
+
 	// Defer OpenLevel by ~0.15 s so ULoadingScreenManager has enough frames to
 	// fully show the loading screen before the game thread is blocked by the
 	// synchronous level load (FlushAsyncLoading etc.).
@@ -223,6 +331,7 @@ void UMYSTLevelLoadingSubsystem::ExecutePendingLevelTravel()
 	if (!World || CurrentPhase == EMYSTLevelLoadPhase::Idle)
 	{
 		// Cancelled or world gone — bail out cleanly
+		CurrentLoadTimings.bMapLoadFailed = true;
 		AdvanceToIdle();
 		return;
 	}
@@ -258,6 +367,16 @@ void UMYSTLevelLoadingSubsystem::ExecutePendingLevelTravel()
 		GetMoviePlayer()->SetupLoadingScreen(TickableScreen);
 	}
 
+	// The map package is resident (or in flight) by now and LoadMap will pick it up
+	// from memory. Holding it any longer would root the outgoing world's package
+	// through LoadMap's garbage collect if this is a reload of the same map.
+	ReleaseTargetMapPreload();
+	if (TargetPreloadHandle.IsValid() && TargetPreloadHandle->HasLoadCompleted() && CurrentLoadTimings.PreloadSeconds < 0.f)
+	{
+		// The experience finished first and was waiting on the map handle we just cancelled
+		HandleTargetPreloadComplete();
+	}
+
 	UGameplayStatics::OpenLevel(World, FName(*PendingMapPath), bPendingAbsolute);
 }
 
@@ -288,6 +407,7 @@ void UMYSTLevelLoadingSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
 	if (!LoadedWorld)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("MYSTLevelLoadingSubsystem: PostLoadMap fired with null world."));
+		CurrentLoadTimings.bMapLoadFailed = true;
 		AdvanceToIdle();
 		return;
 	}
@@ -295,12 +415,37 @@ void UMYSTLevelLoadingSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
 	LoadedWorldRef = LoadedWorld;
 	CurrentPhase   = EMYSTLevelLoadPhase::WaitingForStreaming;
 	PhaseStartTime = FPlatformTime::Seconds();
+	MapLoadedTime  = PhaseStartTime;
+
+	// PSO precompilation for the new map starts now and overlaps streaming, so
+	// capture the total here rather than when streaming finishes.
+	TotalPSOsAtStart = static_cast<int32>(FShaderPipelineCache::NumPrecompilesRemaining());
+	CurrentLoadTimings.MapSeconds    = (float)(MapLoadedTime - LoadStartTime);
+	CurrentLoadTimings.PSOsAtMapLoad = TotalPSOsAtStart;
+
+	LoadRecorder.MarkMapLoaded(LoadedWorld);
 
 	UE_LOG(LogTemp, Log,
 		TEXT("MYSTLevelLoadingSubsystem: Map '%s' loaded — entering WaitingForStreaming phase."),
 		*LoadedWorld->GetName());
 }
 
+void UMYSTLevelLoadingSubsystem::HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+	if (CurrentPhase != EMYSTLevelLoadPhase::WaitingForMap)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning,
+		TEXT("MYSTLevelLoadingSubsystem: Travel to '%s' failed (%s: %s) — advancing to Idle."),
+		*CurrentLoadTimings.MapPath, ETravelFailure::ToString(FailureType), *ErrorString);
+
+	GetGameInstance()->GetTimerManager().ClearTimer(PendingTravelTimerHandle);
+	CurrentLoadTimings.bMapLoadFailed = true;
+	AdvanceToIdle();
+}
+
 void UMYSTLevelLoadingSubsystem::AdvanceToWaitingForPSO()
 {
 	OnStreamingComplete.Broadcast();
@@ -308,7 +453,9 @@ void UMYSTLevelLoadingSubsystem::AdvanceToWaitingForPSO()
 	CurrentPhase     = EMYSTLevelLoadPhase::WaitingForPSO;
 	PhaseStartTime   = FPlatformTime::Seconds();
 	AllGatesClearedTime = 0.0;
-	TotalPSOsAtStart = static_cast<int32>(FMath::Max(FShaderPipelineCache::NumPrecompilesRemaining(), 1u));
+	TotalPSOsAtStart = FMath::Max3(TotalPSOsAtStart, static_cast<int32>(FShaderPipelineCache::NumPrecompilesRemaining()), 1);
+
+	CurrentLoadTimings.StreamingSeconds = (float)(PhaseStartTime - MapLoadedTime);
 
 	UE_LOG(LogTemp, Log,
 		TEXT("MYSTLevelLoadingSubsystem: Streaming complete — entering WaitingForPSO phase (%d shaders remaining)."),
@@ -329,13 +476,361 @@ void UMYSTLevelLoadingSubsystem::AdvanceToIdle()
 		OnShadersComplete.Broadcast();
 	}
 
+	const bool bWasLoading = (CurrentPhase != EMYSTLevelLoadPhase::Idle);
+
 	CurrentPhase = EMYSTLevelLoadPhase::Idle;
 	AllGatesClearedTime = 0.0;
 
+	ReleaseTargetPreload();
 	UnregisterFromLoadingManager();
+
+	if (bWasLoading)
+	{
+		CurrentLoadTimings.TotalSeconds = (float)(FPlatformTime::Seconds() - LoadStartTime);
+		CurrentLoadTimings.GCSeconds    = (float)LoadRecorder.GetGCSeconds();
+		LastLoadTimings = CurrentLoadTimings;
+
+		LoadRecorder.End(LastLoadTimings, bWriteLoadReports);
+
+		UE_LOG(LogTemp, Log,
+			TEXT("MYSTLevelLoadingSubsystem: '%s' took %.2f s (map %.2f s, streaming %.2f s, PSO %.2f s for %d precompiles, preload %.2f s / %d packages / %.1f MB)."),
+			*LastLoadTimings.MapPath, LastLoadTimings.TotalSeconds, LastLoadTimings.MapSeconds,
+			LastLoadTimings.StreamingSeconds, LastLoadTimings.PSOSeconds, LastLoadTimings.PSOsAtMapLoad,
+			LastLoadTimings.PreloadSeconds, LastLoadTimings.PreloadedPackages,
+			(double)LastLoadTimings.PreloadedBytes / (1024.0 * 1024.0));
+	}
+
 	OnLoadingComplete.Broadcast();
 
 	UE_LOG(LogTemp, Log, TEXT("MYSTLevelLoadingSubsystem: Loading complete — loading screen released."));
+
+	// Benchmark: record and move on next tick, once this transition has fully unwound.
+	if (bWasLoading && BenchmarkMaps.Num() > 0)
+	{
+		BenchmarkResults.Add(LastLoadTimings);
+		GetGameInstance()->GetTimerManager().SetTimerForNextTick(this, &UMYSTLevelLoadingSubsystem::ContinueLoadBenchmark);
+	}
+}
+
+void UMYSTLevelLoadingSubsystem::StartLoadBenchmark(const TArray<FString>& MapPaths, int32 Iterations, float MaxSecondsPerLoad, bool bExitWhenDone)
+{
+	if (MapPaths.Num() == 0 || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MYSTLevelLoadingSubsystem: StartLoadBenchmark needs at least one map and one iteration."));
+		return;
+	}
+
+	if (BenchmarkMaps.Num() > 0 || CurrentPhase != EMYSTLevelLoadPhase::Idle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MYSTLevelLoadingSubsystem: StartLoadBenchmark called while a load or benchmark is in progress. Ignoring."));
+		return;
+	}
+
+	BenchmarkMaps              = MapPaths;
+	BenchmarkResults.Reset();
+	BenchmarkTravelsRemaining  = MapPaths.Num() * Iterations;
+	BenchmarkNextMapIndex      = 0;
+	BenchmarkMaxSecondsPerLoad = MaxSecondsPerLoad;
+	bBenchmarkExitWhenDone     = bExitWhenDone;
+
+	UE_LOG(LogTemp, Log, TEXT("MYSTLevelLoadingSubsystem: Starting load benchmark — %d map(s) x %d iteration(s)."), MapPaths.Num(), Iterations);
+
+	ContinueLoadBenchmark();
+}
+
+void UMYSTLevelLoadingSubsystem::ContinueLoadBenchmark()
+{
+	if (BenchmarkMaps.Num() == 0)
+	{
+		return;
+	}
+
+	if (BenchmarkTravelsRemaining <= 0)
+	{
+		FinishLoadBenchmark();
+		return;
+	}
+
+	--BenchmarkTravelsRemaining;
+	const FString MapPath = BenchmarkMaps[BenchmarkNextMapIndex];
+	BenchmarkNextMapIndex = (BenchmarkNextMapIndex + 1) % BenchmarkMaps.Num();
+
+	RequestLevelTravel(MapPath, /*bAbsolute=*/true);
+
+	// The travel was refused outright, record it as failed and keep going
+	if (CurrentPhase == EMYSTLevelLoadPhase::Idle)
+	{
+		FMYSTLevelLoadTimings FailedTimings;
+		FailedTimings.MapPath = MapPath;
+		FailedTimings.bMapLoadFailed = true;
+		BenchmarkResults.Add(FailedTimings);
+
+		GetGameInstance()->GetTimerManager().SetTimerForNextTick(this, &UMYSTLevelLoadingSubsystem::ContinueLoadBenchmark);
+	}
+}
+
+void UMYSTLevelLoadingSubsystem::FinishLoadBenchmark()
+{
+	bool bRegressed = false;
+
+	UE_LOG(LogTemp, Display, TEXT("========== MYST Level Load Benchmark =========="));
+	for (const FString& MapPath : BenchmarkMaps)
+	{
+		int32 Count = 0;
+		int32 Failures = 0;
+		float Sum = 0.f;
+		float Worst = 0.f;
+		for (const FMYSTLevelLoadTimings& Result : BenchmarkResults)
+		{
+			if (Result.MapPath != MapPath)
+			{
+				continue;
+			}
+
+			if (Result.bMapLoadFailed)
+			{
+				++Failures;
+				continue;
+			}
+
+			++Count;
+			Sum  += Result.TotalSeconds;
+			Worst = FMath::Max(Worst, Result.TotalSeconds);
+		}
+
+		const bool bMapRegressed = (Count == 0) || (Failures > 0) || (BenchmarkMaxSecondsPerLoad > 0.f && Worst > BenchmarkMaxSecondsPerLoad);
+		bRegressed |= bMapRegressed;
+
+		UE_LOG(LogTemp, Display, TEXT("  %-48s %2d loads  %2d failed  avg %6.2f s  worst %6.2f s  %s"),
+			*MapPath, Count, Failures, Count > 0 ? Sum / Count : 0.f, Worst, bMapRegressed ? TEXT("FAIL") : TEXT("ok"));
+	}
+	UE_LOG(LogTemp, Display, TEXT("  Limit %.2f s per load — %s"), BenchmarkMaxSecondsPerLoad, bRegressed ? TEXT("REGRESSED") : TEXT("PASSED"));
+	UE_LOG(LogTemp, Display, TEXT("==============================================="));
+
+	BenchmarkMaps.Reset();
+
+	if (bBenchmarkExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bRegressed ? 1 : 0);
+	}
+}
+
+void UMYSTLevelLoadingSubsystem::StartTargetPreload(const FString& MapPath)
+{
+	ReleaseTargetPreload();
+
+	if (!UAssetManager::IsInitialized())
+	{
+		return;
+	}
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	// MapPath may carry travel options, e.g. "L_Expanse?Experience=B_ShooterGame_Elimination"
+	FString MapName = MapPath;
+	FString Options;
+	int32 OptionsStart = INDEX_NONE;
+	if (MapPath.FindChar(TEXT('?'), OptionsStart))
+	{
+		MapName = MapPath.Left(OptionsStart);
+		Options = MapPath.Mid(OptionsStart);
+	}
+
+	FString LongPackageName = MapName;
+	if (FPackageName::IsShortPackageName(MapName)
+		&& !FPackageName::SearchForPackageOnDisk(MapName + FPackageName::GetMapPackageExtension(), &LongPackageName))
+	{
+		LongPackageName.Reset();
+	}
+
+	// ---- Map package --------------------------------------------------
+	// Never preload the map we are leaving: it is already loaded, and the handle
+	// would only add one more way to keep the old world alive.
+	TArray<FSoftObjectPath> MapPaths;
+	FPrimaryAssetId MapId;
+	if (FPackageName::IsValidLongPackageName(LongPackageName))
+	{
+		const FSoftObjectPath MapObjectPath(LongPackageName + TEXT(".") + FPackageName::GetShortName(LongPackageName));
+		MapId = AssetManager.GetPrimaryAssetIdForPath(MapObjectPath);
+
+		const UWorld* World = GetWorld();
+		const FString CurrentPackageName = World ? UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()) : FString();
+		if (LongPackageName != CurrentPackageName)
+		{
+			MapPaths.Add(MapObjectPath);
+		}
+	}
+
+	// ---- Experience (+ pawn data, equipment and cue bundles) ----------
+	// An explicit ?Experience= option wins, same as ALyraGameMode. Otherwise use
+	// any user-facing experience already in memory (the front end loads them
+	// for its map list) that points at this map.
+	// Primary asset type names match the class names (see DefaultGame.ini).
+	const FPrimaryAssetType ExperienceType(TEXT("LyraExperienceDefinition"));
+	TArray<FPrimaryAssetId> ExperienceIds;
+
+	const FString ExperienceOption = UGameplayStatics::ParseOption(Options, TEXT("Experience"));
+	if (!ExperienceOption.IsEmpty())
+	{
+		ExperienceIds.Add(FPrimaryAssetId(ExperienceType, FName(*ExperienceOption)));
+	}
+	else if (MapId.IsValid())
+	{
+		TArray<UObject*> UserFacingExperiences;
+		AssetManager.GetPrimaryAssetObjectList(FPrimaryAssetType(ULyraUserFacingExperienceDefinition::StaticClass()->GetFName()), UserFacingExperiences);
+		for (const UObject* Object : UserFacingExperiences)
+		{
+			const ULyraUserFacingExperienceDefinition* UserFacing = Cast<ULyraUserFacingExperienceDefinition>(Object);
+			if (UserFacing && UserFacing->MapID == MapId && UserFacing->ExperienceID.IsValid())
+			{
+				ExperienceIds.AddUnique(UserFacing->ExperienceID);
+			}
+		}
+	}
+
+	// Same bundle set ULyraExperienceManagerComponent asks for, so its load
+	// after travel finds everything already resident. Gameplay cues referenced
+	// by these assets are picked up by ULyraGameplayCueManager's preload-on-
+	// reference path as they load.
+	TArray<FName> Bundles;
+	Bundles.Add(FLyraBundles::Equipped);
+	Bundles.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	if (!IsRunningDedicatedServer())
+	{
+		Bundles.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+
+	// The map and the experience get separate handles: the map handle has to be
+	// dropped before OpenLevel, the experience one is kept across travel.
+	if (MapPaths.Num() > 0)
+	{
+		TargetMapPreloadHandle = AssetManager.GetStreamableManager().RequestAsyncLoad(MapPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, /*bManageActiveHandle=*/false, /*bStartStalled=*/false, TEXT("MYSTLevelPreload_Map"));
+	}
+	if (ExperienceIds.Num() > 0)
+	{
+		TargetPreloadHandle = AssetManager.LoadPrimaryAssets(ExperienceIds, Bundles, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	if (!TargetMapPreloadHandle.IsValid() && !TargetPreloadHandle.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Log,
+		TEXT("MYSTLevelLoadingSubsystem: Preloading '%s'%s and %d experience(s) ahead of travel."),
+		*LongPackageName, TargetMapPreloadHandle.IsValid() ? TEXT("") : TEXT(" (map skipped)"), ExperienceIds.Num());
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : { TargetMapPreloadHandle, TargetPreloadHandle })
+	{
+		if (Handle.IsValid() && !Handle->HasLoadCompleted())
+		{
+			Handle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &UMYSTLevelLoadingSubsystem::HandleTargetPreloadComplete));
+		}
+	}
+	HandleTargetPreloadComplete();
+}
+
+void UMYSTLevelLoadingSubsystem::HandleTargetPreloadComplete()
+{
+	// Collect from whichever handles have finished. The map handle may already be
+	// gone by the time the experience completes, so remember what it brought in.
+	bool bStillLoading = false;
+	for (const TSharedPtr<FStreamableHandle>& Handle : { TargetMapPreloadHandle, TargetPreloadHandle })
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+		if (!Handle->HasLoadCompleted())
+		{
+			bStillLoading = true;
+			continue;
+		}
+
+		TArray<UObject*> LoadedAssets;
+		Handle->GetLoadedAssets(LoadedAssets);
+		for (const UObject* Asset : LoadedAssets)
+		{
+			if (Asset)
+			{
+				PreloadedPackageNames.Add(Asset->GetPackage()->GetFName());
+			}
+		}
+	}
+
+	if (bStillLoading)
+	{
+		return;
+	}
+
+	CurrentLoadTimings.PreloadSeconds = (float)(FPlatformTime::Seconds() - LoadStartTime);
+
+	// Sum the on-disk package sizes so transitions can be compared by bytes, not just seconds.
+	int64 TotalBytes = 0;
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		for (const FName PackageName : PreloadedPackageNames)
+		{
+			if (const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName))
+			{
+				TotalBytes += FMath::Max<int64>(PackageData->DiskSize, 0);
+			}
+		}
+	}
+
+	CurrentLoadTimings.PreloadedPackages = PreloadedPackageNames.Num();
+	CurrentLoadTimings.PreloadedBytes    = TotalBytes;
+}
+
+void UMYSTLevelLoadingSubsystem::ReleaseTargetPreload()
+{
+	ReleaseTargetMapPreload();
+	PreloadedPackageNames.Reset();
+
+	if (TargetPreloadHandle.IsValid())
+	{
+		// By the time we go Idle the world and experience hold their own
+		// references; if we are cancelled mid-load this stops the request.
+		if (!TargetPreloadHandle->HasLoadCompleted())
+		{
+			TargetPreloadHandle->CancelHandle();
+		}
+		else
+		{
+			TargetPreloadHandle->ReleaseHandle();
+		}
+		TargetPreloadHandle.Reset();
+	}
+
+	if (bOverridingPSOBatchMode)
+	{
+		bOverridingPSOBatchMode = false;
+
+		// If the loading screen was shown or hidden since, ULoadingScreenManager already applied its own mode
+		// on top of ours and that is the one to keep
+		const UGameInstance* GI = GetGameInstance();
+		const ULoadingScreenManager* LoadingScreenManager = GI ? GI->GetSubsystem<ULoadingScreenManager>() : nullptr;
+		const bool bLoadingScreenShown = LoadingScreenManager && LoadingScreenManager->GetLoadingScreenDisplayStatus();
+		if (bLoadingScreenShown == bLoadingScreenShownWhenOverridingPSOBatchMode)
+		{
+			FShaderPipelineCache::SetBatchMode(bLoadingScreenShownWhenOverridingPSOBatchMode ? FShaderPipelineCache::BatchMode::Fast : FShaderPipelineCache::BatchMode::Background);
+		}
+	}
+}
+
+void UMYSTLevelLoadingSubsystem::ReleaseTargetMapPreload()
+{
+	if (TargetMapPreloadHandle.IsValid())
+	{
+		if (!TargetMapPreloadHandle->HasLoadCompleted())
+		{
+			TargetMapPreloadHandle->CancelHandle();
+		}
+		else
+		{
+			TargetMapPreloadHandle->ReleaseHandle();
+		}
+		TargetMapPreloadHandle.Reset();
+	}
 }
 
 bool UMYSTLevelLoadingSubsystem::AreAllStreamingLevelsReady(UWorld* World) const
@@ -8,6 +8,7 @@
 #include "BTService_AIStateObserver.generated.h"
 
 class ULyraHealthComponent;
+struct FLyraHealthEvent;
 
 /**
  * BT Service: AI State Observer (MYST)
@@ -24,8 +25,9 @@ class ULyraHealthComponent;
  *  │ TargetIsLowHealth  (Bool)    │ Target normalized health < LowHealthThreshold             │
  *  └──────────────────────────────┴──────────────────────────────────────────────────────────┘
  *
- * HasTakenDamageRecently is driven by a delegate bound to ULyraHealthComponent::OnHealthChanged
- * rather than tick-based health polling, so it fires exactly when damage lands and the cooldown
+ * HasTakenDamageRecently is driven by the AI pawn's events from ULyraHealthEventSubsystem
+ * rather than tick-based health polling, so it arms at the end of the frame the damage lands in
+ * (even for pawns whose health component doesn't broadcast OnHealthChanged) and the cooldown
  * is measured in real world-time seconds.  bCreateNodeInstance = true gives each AI its own
  * UObject instance so per-AI state is stored as plain member variables.
  *
@@ -52,10 +54,9 @@ public:
 	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
 	/**
-	 * Safety net: unbind the health delegate if GC collects this node instance
-	 * before OnCeaseRelevant fires (e.g. forceful actor destroy during PIE stop).
-	 * Without this, ULyraHealthComponent::OnHealthChanged retains a dangling
-	 * FScriptDelegate pointing to the destroyed UObject.
+	 * Safety net: unregister from the health event stream if GC collects this
+	 * node instance before OnCeaseRelevant fires (e.g. forceful actor destroy
+	 * during PIE stop), so the subsystem doesn't keep a consumer entry for it.
 	 */
 	virtual void BeginDestroy() override;
 
@@ -130,15 +131,16 @@ protected:
 
 private:
 
-	/**
-	 * Delegate callback bound to ULyraHealthComponent::OnHealthChanged.
-	 * Updates LastDamageTime when a qualifying hit lands.
-	 * Must be a UFUNCTION so the dynamic multicast delegate can bind to it.
-	 */
-	UFUNCTION()
+	/** Registers with ULyraHealthEventSubsystem for HealthComp's events. */
+	void BindHealthEvents(ULyraHealthComponent* HealthComp);
+
+	/** The AI pawn's health events for the frame, forwards health changes to OnAIHealthChanged. */
+	void HandleHealthEvents(TConstArrayView<FLyraHealthEvent> Events);
+
+	/** Updates LastDamageTime when a qualifying hit lands. */
 	void OnAIHealthChanged(ULyraHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* Instigator);
 
-	/** Unbinds and clears the health delegate. Safe to call even if nothing is bound. */
+	/** Unregisters from the health event stream. Safe to call even if nothing is bound. */
 	void UnbindHealthDelegate();
 
 	// Per-AI instance state (valid because bCreateNodeInstance = true).
@@ -153,6 +155,9 @@ private:
 	/** Weak ref to the health component we're listening to, used for unbinding. */
 	TWeakObjectPtr<ULyraHealthComponent> TrackedHealthComp;
 
+	/** Our consumer registration with ULyraHealthEventSubsystem for TrackedHealthComp. */
+	FDelegateHandle HealthEventsHandle;
+
 	/** Weak ref to the BT component, used to write the BB from the health callback. */
 	TWeakObjectPtr<UBehaviorTreeComponent> OwnerBTComp;
 };
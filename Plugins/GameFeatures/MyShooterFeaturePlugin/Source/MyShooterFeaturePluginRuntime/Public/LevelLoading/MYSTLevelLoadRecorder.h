@@ -0,0 +1,89 @@
+﻿// Copyright MyShooterScenarios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+struct FMYSTLevelLoadTimings;
+
+/**
+ * Collects the detailed timeline of a single level transition and, when asked
+ * to, writes it out as a JSON + CSV report when the transition finishes.
+ *
+ * Owned by UMYSTLevelLoadingSubsystem, which feeds it from its phase
+ * transitions and Tick on every transition in non-shipping builds. Reports land
+ * in Saved/Profiling/LevelLoads/. All times are seconds since Begin(), which is
+ * called from RequestLevelTravel.
+ *
+ * Recorded per transition:
+ *   - phase timings (FMYSTLevelLoadTimings)
+ *   - when each streaming level became loaded / visible
+ *   - PSO precompiles remaining, sampled over time
+ *   - garbage collection count + time
+ *   - time the async loader had nothing queued while we were still waiting
+ *     (sampled on the game thread, so it is tick-granular)
+ */
+class MYSHOOTERFEATUREPLUGINRUNTIME_API FMYSTLevelLoadRecorder
+{
+public:
+
+	~FMYSTLevelLoadRecorder();
+
+	/** Starts a new recording, discarding anything in progress. */
+	void Begin(const FString& InMapPath);
+
+	/** PostLoadMap fired. Like every other recorded time, stored as seconds since Begin(). */
+	void MarkMapLoaded(UWorld* World);
+
+	/** Samples PSO / async loading / streaming state. Call every tick while loading. */
+	void Sample(UWorld* World);
+
+	/** Finishes the recording and, if bWriteReport, writes the report. Returns the JSON path, or empty if nothing was written. */
+	FString End(const FMYSTLevelLoadTimings& Timings, bool bWriteReport);
+
+	bool IsRecording() const { return bRecording; }
+
+	/** Seconds spent in garbage collection during the last/current recording. */
+	double GetGCSeconds() const { return GCSeconds; }
+
+private:
+
+	struct FStreamingLevelRecord
+	{
+		FName PackageName;
+		double LoadedTime = -1.0;
+		double VisibleTime = -1.0;
+	};
+
+	struct FPSOSample
+	{
+		double Time = 0.0;
+		int32 Remaining = 0;
+	};
+
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+	void UnbindGCDelegates();
+
+	double SinceStart(double Now) const { return Now - StartTime; }
+
+	FString MapPath;
+	bool bRecording = false;
+
+	double StartTime = 0.0;
+	double MapLoadedTime = -1.0;
+	double LastSampleTime = 0.0;
+
+	TArray<FStreamingLevelRecord> StreamingLevels;
+	TArray<FPSOSample> PSOSamples;
+
+	int32 GCCount = 0;
+	double GCSeconds = 0.0;
+	double GCStartTime = 0.0;
+
+	double AsyncLoadingIdleSeconds = 0.0;
+
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
@@ -4,13 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Tickable.h"
 #include "LoadingProcessInterface.h"
+#include "UObject/PrimaryAssetId.h"
+#include "LevelLoading/MYSTLevelLoadRecorder.h"
 
 #include "MYSTLevelLoadingSubsystem.generated.h"
 
 class ULoadingScreenManager;
 class UWorld;
+struct FStreamableHandle;
 
 // ---------------------------------------------------------------------------
 // Phase enum — tracks where in the load cycle we are
@@ -36,6 +40,65 @@ enum class EMYSTLevelLoadPhase : uint8
 	WaitingForPSO		UMETA(DisplayName = "Waiting For PSO"),
 };
 
+// ---------------------------------------------------------------------------
+// Timings
+// ---------------------------------------------------------------------------
+
+/**
+ * Wall-clock breakdown of a single level transition.
+ * Phases overlap (preload runs during teardown + map load, PSO compiles while
+ * streaming), so the individual phase times do not add up to TotalSeconds.
+ */
+USTRUCT(BlueprintType)
+struct FMYSTLevelLoadTimings
+{
+	GENERATED_BODY()
+
+	/** Map that was travelled to. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	FString MapPath;
+
+	/** RequestLevelTravel → PostLoadMap. Includes the loading screen show delay. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float MapSeconds = 0.f;
+
+	/** PostLoadMap → all streaming levels visible. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float StreamingSeconds = 0.f;
+
+	/** PostLoadMap → PSO precompile queue drained (runs alongside streaming). */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float PSOSeconds = 0.f;
+
+	/** RequestLevelTravel → background preload finished. < 0 if nothing was preloaded. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float PreloadSeconds = -1.f;
+
+	/** RequestLevelTravel → loading screen released. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float TotalSeconds = 0.f;
+
+	/** PSO precompiles outstanding when the map finished loading. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	int32 PSOsAtMapLoad = 0;
+
+	/** Number of packages pulled in by the background preload. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	int32 PreloadedPackages = 0;
+
+	/** On-disk size of the preloaded packages, from the asset registry. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	int64 PreloadedBytes = 0;
+
+	/** Time spent in garbage collection during the transition. */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	float GCSeconds = 0.f;
+
+	/** True if the map never loaded (travel failure or WaitingForMap timeout). */
+	UPROPERTY(BlueprintReadOnly, Category = "MYST|Level Loading")
+	bool bMapLoadFailed = false;
+};
+
 // ---------------------------------------------------------------------------
 // Delegate payload structs
 // ---------------------------------------------------------------------------
@@ -53,9 +116,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMYSTShaderProgressDelegate, float,
  * Call RequestLevelTravel() instead of OpenLevel directly. This subsystem:
  *   1. Registers itself with the CommonLoadingScreen manager so the loading
  *      screen appears immediately and does NOT hide until all phases pass.
- *   2. Waits for all streaming levels / World Partition cells to become visible.
- *   3. Waits for PSO (pipeline state object) shader precompilation to drain.
- *   4. Broadcasts Blueprint-assignable delegates at each phase transition.
+ *   2. Starts an async preload of the target map package and its experience
+ *      (plus pawn data / equipment bundles) while the old world tears down.
+ *   3. Waits for all streaming levels / World Partition cells to become visible,
+ *      with PSO precompilation running in fast batch mode at the same time.
+ *   4. Waits for PSO (pipeline state object) shader precompilation to drain.
+ *   5. Broadcasts Blueprint-assignable delegates at each phase transition and
+ *      records per-phase timings (GetLastLoadTimings).
  *
  * The loading screen is driven by ILoadingProcessInterface — this subsystem
  * simply returns true from ShouldShowLoadingScreen() until the Idle phase is
@@ -133,6 +200,48 @@ public:
 	UFUNCTION(BlueprintPure, Category = "MYST|Level Loading")
 	float GetShaderPrecompileProgress() const;
 
+	/** Timings of the most recently completed transition. */
+	UFUNCTION(BlueprintPure, Category = "MYST|Level Loading")
+	const FMYSTLevelLoadTimings& GetLastLoadTimings() const { return LastLoadTimings; }
+
+	/**
+	 * Start async loading the target map and its experience as soon as travel
+	 * is requested, instead of waiting for LoadMap to discover them.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MYST|Level Loading")
+	bool bPreloadTargetAssets = true;
+
+	/**
+	 * Switch the PSO cache to fast batching while the loading screen is up so
+	 * precompilation overlaps streaming instead of trickling in afterwards.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MYST|Level Loading")
+	bool bFastPSOPrecompileDuringLoad = true;
+
+	/**
+	 * Write a JSON + CSV timeline of every transition to
+	 * Saved/Profiling/LevelLoads/ (see FMYSTLevelLoadRecorder). The timeline
+	 * is recorded either way in non-shipping builds and feeds the GC time in
+	 * GetLastLoadTimings(); this only controls the file. Never written in
+	 * shipping builds.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MYST|Level Loading")
+	bool bWriteLoadReports = false;
+
+	/**
+	 * Travels through MapPaths in order, Iterations times, and fails if any
+	 * transition takes longer than MaxSecondsPerLoad (0 = no limit) or a
+	 * travel fails. A travel that never reaches PostLoadMap is given up on after
+	 * PhaseTimeoutSeconds (or 120 s if that is 0) and counts as a failure.
+	 *
+	 * Headless regression run:
+	 *   UnrealEditor-Cmd MyShooter -game -nullrhi -unattended
+	 *     -ExecCmds="MYST.LevelLoad.Benchmark 5 20 /Game/Maps/L_A /Game/Maps/L_B"
+	 * With bExitWhenDone the process exits with code 1 on a regression.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MYST|Level Loading")
+	void StartLoadBenchmark(const TArray<FString>& MapPaths, int32 Iterations = 3, float MaxSecondsPerLoad = 0.f, bool bExitWhenDone = false);
+
 	/**
 	 * Maximum seconds to wait in WaitingForStreaming or WaitingForPSO before
 	 * forcibly advancing. Set to 0 to disable. Default: 30 s.
@@ -186,6 +295,9 @@ private:
 	/** Bound to FCoreUObjectDelegates::PostLoadMapWithWorld */
 	void HandlePostLoadMap(UWorld* LoadedWorld);
 
+	/** Ends the transition as failed if the travel we started could not complete. */
+	void HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+
 	/** Advance from WaitingForStreaming → WaitingForPSO */
 	void AdvanceToWaitingForPSO();
 
@@ -195,6 +307,22 @@ private:
 	/** True when all requested streaming levels in World are loaded+visible. */
 	bool AreAllStreamingLevelsReady(UWorld* World) const;
 
+	/** Kicks off the async preload of the map package + experience for MapPath. */
+	void StartTargetPreload(const FString& MapPath);
+
+	/** Called as each preload handle completes; records timings and bytes once nothing is left loading. */
+	void HandleTargetPreloadComplete();
+
+	/** Drops the preload handles and restores the PSO batch mode. */
+	void ReleaseTargetPreload();
+
+	/** Drops the map package handle. Must happen before OpenLevel so it cannot keep a world alive through LoadMap's GC. */
+	void ReleaseTargetMapPreload();
+
+	/** Travels to the next benchmark map, or reports results when done. */
+	void ContinueLoadBenchmark();
+	void FinishLoadBenchmark();
+
 	/** Register / unregister this subsystem with ULoadingScreenManager. */
 	void RegisterWithLoadingManager();
 	void UnregisterFromLoadingManager();
@@ -214,11 +342,49 @@ private:
 	/** Total PSO precompiles at the start of the WaitingForPSO phase (for %). */
 	int32 TotalPSOsAtStart = 0;
 
+	/** Wall-clock time RequestLevelTravel was called / PostLoadMap fired. */
+	double LoadStartTime = 0.0;
+	double MapLoadedTime = 0.0;
+
+	/** True once the PSO queue has drained at least once since PostLoadMap. */
+	bool bPSOsDrained = false;
+
+	/** Timings being filled in for the transition in flight, and the last finished one. */
+	FMYSTLevelLoadTimings CurrentLoadTimings;
+	FMYSTLevelLoadTimings LastLoadTimings;
+
+	/** Keeps the preloaded experience and its bundles alive across the LoadMap garbage collect. */
+	TSharedPtr<FStreamableHandle> TargetPreloadHandle;
+
+	/** Streams the target map package in while the loading screen comes up. Released before OpenLevel. */
+	TSharedPtr<FStreamableHandle> TargetMapPreloadHandle;
+
+	/** Packages pulled in by the preload handles so far, for PreloadedPackages / PreloadedBytes. */
+	TSet<FName> PreloadedPackageNames;
+
+	/** True while we hold the PSO batch mode at Fast, so it can be handed back on release. */
+	bool bOverridingPSOBatchMode = false;
+
+	/** Whether CommonLoadingScreen was showing its screen when we took over the batch mode, which tells us the mode it had set. */
+	bool bLoadingScreenShownWhenOverridingPSOBatchMode = false;
+
+	/** Detailed per-transition timeline, written out when we go Idle. */
+	FMYSTLevelLoadRecorder LoadRecorder;
+
+	/** Load benchmark state — BenchmarkMaps is empty when no benchmark is running. */
+	TArray<FString> BenchmarkMaps;
+	TArray<FMYSTLevelLoadTimings> BenchmarkResults;
+	int32 BenchmarkTravelsRemaining = 0;
+	int32 BenchmarkNextMapIndex = 0;
+	float BenchmarkMaxSecondsPerLoad = 0.f;
+	bool  bBenchmarkExitWhenDone = false;
+
 	/** Set after PostLoadMapWithWorld fires; used to avoid world pointer stale. */
 	TWeakObjectPtr<UWorld> LoadedWorldRef;
 
 	/** Handle for the PostLoadMapWithWorld delegate binding. */
 	FDelegateHandle PostLoadMapDelegateHandle;
+	FDelegateHandle TravelFailureDelegateHandle;
 
 	/**
 	 * Deferred travel — stored so the short timer callback can execute it.
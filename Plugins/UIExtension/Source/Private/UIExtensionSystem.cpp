@@ -3,13 +3,37 @@
 #include "UIExtensionSystem.h"
 
 #include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 #include "LogUIExtension.h"
+#include "Misc/OutputDevice.h"
 #include "UObject/Stack.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIExtensionSystem)
 
 class FSubsystemCollectionBase;
 
+namespace UIExtensionCVars
+{
+	static float WidgetConstructionBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarWidgetConstructionBudgetMs(
+		TEXT("UIExtension.WidgetConstructionBudgetMs"),
+		WidgetConstructionBudgetMs,
+		TEXT("Milliseconds per frame extension point widgets may spend constructing extension widgets, the rest is spread over the next frames. 0 constructs everything immediately"),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CCmdDumpWidgetConstructionStats(
+		TEXT("UIExtension.DumpWidgetConstructionStats"),
+		TEXT("Shows how many extension widgets were constructed and how long it took, worst frame included"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (const UUIExtensionSubsystem* ExtensionSubsystem = World ? World->GetSubsystem<UUIExtensionSubsystem>() : nullptr)
+			{
+				ExtensionSubsystem->DumpWidgetConstructionStats(Ar);
+			}
+		}));
+}
+
 //=========================================================
 
 void FUIExtensionPointHandle::Unregister()
@@ -45,13 +69,23 @@ bool FUIExtensionPoint::DoesExtensionPassContract(const FUIExtension* Extension)
 		{
 			// The data can either be the literal class of the data type, or a instance of the class type.
 			const UClass* DataClass = DataPtr->IsA(UClass::StaticClass()) ? Cast<UClass>(DataPtr) : DataPtr->GetClass();
+			if (const bool* bCachedResult = DataClassContractCache.Find(DataClass))
+			{
+				return *bCachedResult;
+			}
+
+			bool bPassesContract = false;
 			for (const UClass* AllowedDataClass : AllowedDataClasses)
 			{
 				if (DataClass->IsChildOf(AllowedDataClass) || DataClass->ImplementsInterface(AllowedDataClass))
 				{
-					return true;
+					bPassesContract = true;
+					break;
 				}
 			}
+
+			DataClassContractCache.Add(DataClass, bPassesContract);
+			return bPassesContract;
 		}
 	}
 
@@ -96,6 +130,13 @@ void UUIExtensionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUIExtensionSubsystem::Deinitialize()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(WidgetConstructionTickHandle);
+	WidgetConstructionTickHandle.Reset();
+	PendingWidgetConstruction.Reset();
+
+	PendingAddedExtensions.Reset();
+	TagLineageCache.Reset();
+
 	Super::Deinitialize();
 }
 
@@ -188,7 +229,11 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 
 void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
-	for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUIExtensionSubsystem_NotifyExtensionPointOfExtensions);
+
+	// Copy in case a callback registers something with a new tag and the cache reallocates
+	const TArray<FGameplayTag> TagLineage = GetTagLineage(ExtensionPoint->ExtensionPointTag);
+	for (const FGameplayTag& Tag : TagLineage)
 	{
 		if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
 		{
@@ -197,6 +242,12 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 
 			for (const TSharedPtr<FUIExtension>& Extension : ExtensionArray)
 			{
+				// Extensions still waiting on their batch get announced when it ends
+				if (PendingAddedExtensions.Contains(Extension))
+				{
+					continue;
+				}
+
 				if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
 				{
 					FUIExtensionRequest Request = CreateExtensionRequest(Extension);
@@ -214,8 +265,27 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 
 void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction Action, TSharedPtr<FUIExtension>& Extension)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUIExtensionSubsystem_NotifyExtensionPointsOfExtension);
+
+	if (Action == EUIExtensionAction::Added)
+	{
+		if (ExtensionBatchDepth > 0)
+		{
+			PendingAddedExtensions.Add(Extension);
+			return;
+		}
+	}
+	else if (PendingAddedExtensions.RemoveSingleSwap(Extension) > 0)
+	{
+		// Removed before its batch ended, nobody heard about it being added
+		return;
+	}
+
+	// Copy in case a callback registers something with a new tag and the cache reallocates
+	const TArray<FGameplayTag> TagLineage = GetTagLineage(Extension->ExtensionPointTag);
+
 	bool bOnInitialTag = true;
-	for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	for (const FGameplayTag& Tag : TagLineage)
 	{
 		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
 		{
@@ -239,6 +309,210 @@ void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction
 	}
 }
 
+void UUIExtensionSubsystem::BeginExtensionBatch()
+{
+	++ExtensionBatchDepth;
+}
+
+void UUIExtensionSubsystem::EndExtensionBatch()
+{
+	if (!ensure(ExtensionBatchDepth > 0) || (--ExtensionBatchDepth > 0))
+	{
+		return;
+	}
+
+	if (PendingAddedExtensions.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUIExtensionSubsystem_EndExtensionBatch);
+
+	const FExtensionList AddedExtensions = MoveTemp(PendingAddedExtensions);
+	PendingAddedExtensions.Reset();
+
+	// Group the new extensions by the extension points that should hear about them, in the order the points are found
+	TArray<TPair<TSharedPtr<FUIExtensionPoint>, FExtensionList>> ExtensionsByPoint;
+	TMap<const FUIExtensionPoint*, int32> PointToGroupIndex;
+
+	for (const TSharedPtr<FUIExtension>& Extension : AddedExtensions)
+	{
+		const TArray<FGameplayTag>& TagLineage = GetTagLineage(Extension->ExtensionPointTag);
+		for (int32 TagIndex = 0; TagIndex < TagLineage.Num(); ++TagIndex)
+		{
+			const FExtensionPointList* ListPtr = ExtensionPointMap.Find(TagLineage[TagIndex]);
+			if (ListPtr == nullptr)
+			{
+				continue;
+			}
+
+			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : *ListPtr)
+			{
+				const bool bOnInitialTag = (TagIndex == 0);
+				if ((bOnInitialTag || (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch)) && ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
+				{
+					int32& GroupIndex = PointToGroupIndex.FindOrAdd(ExtensionPoint.Get(), INDEX_NONE);
+					if (GroupIndex == INDEX_NONE)
+					{
+						GroupIndex = ExtensionsByPoint.Emplace(ExtensionPoint, FExtensionList());
+					}
+					ExtensionsByPoint[GroupIndex].Value.Add(Extension);
+				}
+			}
+		}
+	}
+
+	for (const TPair<TSharedPtr<FUIExtensionPoint>, FExtensionList>& Group : ExtensionsByPoint)
+	{
+		for (const TSharedPtr<FUIExtension>& Extension : Group.Value)
+		{
+			// A previous callback may have unregistered it, in which case it already sent out its removal
+			if (IsExtensionRegistered(Extension))
+			{
+				FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+				Group.Key->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
+			}
+		}
+	}
+}
+
+void UUIExtensionSubsystem::QueueWidgetConstruction(UObject* Owner, const FUIExtensionHandle& ExtensionHandle, TFunction<void()>&& Construct)
+{
+	// Keep the order extensions were added in, so nothing jumps the queue while older work is still pending
+	if ((PendingWidgetConstruction.Num() == 0) && HasWidgetConstructionBudget())
+	{
+		RunWidgetConstruction(Construct);
+		return;
+	}
+
+	FPendingWidgetConstruction& Pending = PendingWidgetConstruction.AddDefaulted_GetRef();
+	Pending.Owner = Owner;
+	Pending.ExtensionHandle = ExtensionHandle;
+	Pending.Construct = MoveTemp(Construct);
+
+	++NumWidgetsDeferred;
+	MaxPendingWidgetConstruction = FMath::Max(MaxPendingWidgetConstruction, PendingWidgetConstruction.Num());
+
+	if (!WidgetConstructionTickHandle.IsValid())
+	{
+		WidgetConstructionTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::ProcessPendingWidgetConstruction));
+	}
+}
+
+bool UUIExtensionSubsystem::CancelWidgetConstruction(UObject* Owner, const FUIExtensionHandle& ExtensionHandle)
+{
+	const int32 NumRemoved = PendingWidgetConstruction.RemoveAll([Owner, &ExtensionHandle](const FPendingWidgetConstruction& Pending)
+	{
+		return (Pending.Owner == Owner) && (Pending.ExtensionHandle == ExtensionHandle);
+	});
+	return NumRemoved > 0;
+}
+
+void UUIExtensionSubsystem::CancelAllWidgetConstruction(UObject* Owner)
+{
+	PendingWidgetConstruction.RemoveAll([Owner](const FPendingWidgetConstruction& Pending)
+	{
+		return Pending.Owner == Owner;
+	});
+}
+
+bool UUIExtensionSubsystem::HasWidgetConstructionBudget()
+{
+	if (UIExtensionCVars::WidgetConstructionBudgetMs <= 0.0f)
+	{
+		return true;
+	}
+
+	if (BudgetFrameNumber != GFrameCounter)
+	{
+		BudgetFrameNumber = GFrameCounter;
+		BudgetUsedSeconds = 0.0;
+	}
+
+	return (BudgetUsedSeconds * 1000.0) < UIExtensionCVars::WidgetConstructionBudgetMs;
+}
+
+void UUIExtensionSubsystem::RunWidgetConstruction(TFunction<void()>& Construct)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUIExtensionSubsystem_RunWidgetConstruction);
+
+	const double StartTime = FPlatformTime::Seconds();
+	Construct();
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	if (BudgetFrameNumber != GFrameCounter)
+	{
+		BudgetFrameNumber = GFrameCounter;
+		BudgetUsedSeconds = 0.0;
+	}
+	BudgetUsedSeconds += Duration;
+
+	++NumWidgetsConstructed;
+	TotalWidgetConstructionSeconds += Duration;
+	MaxFrameWidgetConstructionSeconds = FMath::Max(MaxFrameWidgetConstructionSeconds, BudgetUsedSeconds);
+}
+
+bool UUIExtensionSubsystem::ProcessPendingWidgetConstruction(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UUIExtensionSubsystem_ProcessPendingWidgetConstruction);
+
+	// Always make progress, even if something else already used this frame's budget
+	bool bFirst = true;
+	while ((PendingWidgetConstruction.Num() > 0) && (bFirst || HasWidgetConstructionBudget()))
+	{
+		// Pop before running, constructing may queue or cancel other work
+		FPendingWidgetConstruction Pending = MoveTemp(PendingWidgetConstruction[0]);
+		PendingWidgetConstruction.RemoveAt(0, 1, EAllowShrinking::No);
+
+		if (Pending.Owner.IsValid())
+		{
+			RunWidgetConstruction(Pending.Construct);
+			bFirst = false;
+		}
+	}
+
+	if (PendingWidgetConstruction.Num() == 0)
+	{
+		WidgetConstructionTickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UUIExtensionSubsystem::DumpWidgetConstructionStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("UI extension widgets: %d constructed (%d deferred to a later frame), %d pending"), NumWidgetsConstructed, NumWidgetsDeferred, PendingWidgetConstruction.Num());
+	Ar.Logf(TEXT("  %.2f ms total, %.2f ms average, %.2f ms worst frame, %d most pending at once (budget %.2f ms/frame)"),
+		TotalWidgetConstructionSeconds * 1000.0,
+		(NumWidgetsConstructed > 0) ? (TotalWidgetConstructionSeconds * 1000.0 / NumWidgetsConstructed) : 0.0,
+		MaxFrameWidgetConstructionSeconds * 1000.0,
+		MaxPendingWidgetConstruction,
+		UIExtensionCVars::WidgetConstructionBudgetMs);
+}
+
+const TArray<FGameplayTag>& UUIExtensionSubsystem::GetTagLineage(const FGameplayTag& Tag)
+{
+	if (const TArray<FGameplayTag>* CachedLineage = TagLineageCache.Find(Tag))
+	{
+		return *CachedLineage;
+	}
+
+	TArray<FGameplayTag> Lineage;
+	for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		Lineage.Add(ParentTag);
+	}
+
+	return TagLineageCache.Add(Tag, MoveTemp(Lineage));
+}
+
+bool UUIExtensionSubsystem::IsExtensionRegistered(const TSharedPtr<FUIExtension>& Extension) const
+{
+	const FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag);
+	return (ListPtr != nullptr) && ListPtr->Contains(Extension);
+}
+
 void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& ExtensionHandle)
 {
 	if (ExtensionHandle.IsValid())
@@ -6,6 +6,7 @@
 #include "Editor/WidgetCompilerLog.h"
 #include "Misc/UObjectToken.h"
 #include "CommonLocalPlayer.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerState.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIExtensionPointWidget)
@@ -69,6 +70,14 @@ TSharedRef<SWidget> UUIExtensionPointWidget::RebuildWidget()
 
 void UUIExtensionPointWidget::ResetExtensionPoint()
 {
+	if (UWorld* World = GetWorld())
+	{
+		if (UUIExtensionSubsystem* ExtensionSubsystem = World->GetSubsystem<UUIExtensionSubsystem>())
+		{
+			ExtensionSubsystem->CancelAllWidgetConstruction(this);
+		}
+	}
+
 	ResetInternal();
 
 	ExtensionMapping.Reset();
@@ -116,44 +125,71 @@ void UUIExtensionPointWidget::RegisterExtensionPointForPlayerState(UCommonLocalP
 
 void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action, const FUIExtensionRequest& Request)
 {
+	UWorld* World = GetWorld();
+	UUIExtensionSubsystem* ExtensionSubsystem = World ? World->GetSubsystem<UUIExtensionSubsystem>() : nullptr;
+
 	if (Action == EUIExtensionAction::Added)
 	{
-		UObject* Data = Request.Data;
-		
-		TSubclassOf<UUserWidget> WidgetClass(Cast<UClass>(Data));
-		if (WidgetClass)
+		// Entries come out of the entry box's widget pool, the subsystem spreads the construction of big HUDs over a few frames
+		if (ExtensionSubsystem)
 		{
-			UUserWidget* Widget = CreateEntryInternal(WidgetClass);
-			ExtensionMapping.Add(Request.ExtensionHandle, Widget);
+			ExtensionSubsystem->QueueWidgetConstruction(this, Request.ExtensionHandle, [this, Request]() { AddExtensionWidget(Request); });
 		}
-		else if (DataClasses.Num() > 0)
+		else
 		{
-			if (GetWidgetClassForData.IsBound())
-			{
-				WidgetClass = GetWidgetClassForData.Execute(Data);
-
-				// If the data is irrelevant they can just return no widget class.
-				if (WidgetClass)
-				{
-					if (UUserWidget* Widget = CreateEntryInternal(WidgetClass))
-					{
-						ExtensionMapping.Add(Request.ExtensionHandle, Widget);
-						ConfigureWidgetForData.ExecuteIfBound(Widget, Data);
-					}
-				}
-			}
+			AddExtensionWidget(Request);
 		}
 	}
 	else
 	{
+		// Removed before it ever got built
+		if (ExtensionSubsystem && ExtensionSubsystem->CancelWidgetConstruction(this, Request.ExtensionHandle))
+		{
+			return;
+		}
+
 		if (UUserWidget* Extension = ExtensionMapping.FindRef(Request.ExtensionHandle))
 		{
+			// Goes back to the pool with its Slate widget intact, so the same extension coming back (e.g. after a respawn) is cheap
 			RemoveEntryInternal(Extension);
 			ExtensionMapping.Remove(Request.ExtensionHandle);
 		}
 	}
 }
 
+void UUIExtensionPointWidget::AddExtensionWidget(const FUIExtensionRequest& Request)
+{
+	UObject* Data = Request.Data;
+	if (Data == nullptr)
+	{
+		return;
+	}
+
+	TSubclassOf<UUserWidget> WidgetClass(Cast<UClass>(Data));
+	if (WidgetClass)
+	{
+		UUserWidget* Widget = CreateEntryInternal(WidgetClass);
+		ExtensionMapping.Add(Request.ExtensionHandle, Widget);
+	}
+	else if (DataClasses.Num() > 0)
+	{
+		if (GetWidgetClassForData.IsBound())
+		{
+			WidgetClass = GetWidgetClassForData.Execute(Data);
+
+			// If the data is irrelevant they can just return no widget class.
+			if (WidgetClass)
+			{
+				if (UUserWidget* Widget = CreateEntryInternal(WidgetClass))
+				{
+					ExtensionMapping.Add(Request.ExtensionHandle, Widget);
+					ConfigureWidgetForData.ExecuteIfBound(Widget, Data);
+				}
+			}
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UUIExtensionPointWidget::ValidateCompiledDefaults(IWidgetCompilerLog& CompileLog) const
 {
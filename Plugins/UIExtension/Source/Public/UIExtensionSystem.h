@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "UIExtensionSystem.generated.h"
 
@@ -68,6 +70,10 @@ public:
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
+
+private:
+	// Whether a data class passed the AllowedDataClasses test, the same few widget classes get tested over and over.
+	mutable TMap<TObjectKey<UClass>, bool> DataClassContractCache;
 };
 
 /**
@@ -205,6 +211,25 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Extension")
 	void UnregisterExtensionPoint(const FUIExtensionPointHandle& ExtensionPointHandle);
 
+	/**
+	 * Holds back the 'Added' notifications of extensions registered until the matching EndExtensionBatch, then notifies
+	 * each extension point once with all of its new extensions.  Use FScopedUIExtensionBatch when registering many at once.
+	 */
+	void BeginExtensionBatch();
+	void EndExtensionBatch();
+
+	/**
+	 * Queues the construction of an extension's widget so large HUDs get built over several frames instead of all at once.
+	 * Runs immediately if there's construction budget left this frame, and never runs if Owner goes away first.
+	 */
+	void QueueWidgetConstruction(UObject* Owner, const FUIExtensionHandle& ExtensionHandle, TFunction<void()>&& Construct);
+
+	// Returns true if the construction was still pending, in which case it will no longer run.
+	bool CancelWidgetConstruction(UObject* Owner, const FUIExtensionHandle& ExtensionHandle);
+	void CancelAllWidgetConstruction(UObject* Owner);
+
+	void DumpWidgetConstructionStats(FOutputDevice& Ar) const;
+
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 protected:
@@ -242,11 +267,73 @@ protected:
 	FUIExtensionRequest CreateExtensionRequest(const TSharedPtr<FUIExtension>& Extension);
 
 private:
+	// Returns the tag followed by all of its parents, closest first.
+	const TArray<FGameplayTag>& GetTagLineage(const FGameplayTag& Tag);
+
+	bool IsExtensionRegistered(const TSharedPtr<FUIExtension>& Extension) const;
+
+	bool HasWidgetConstructionBudget();
+	void RunWidgetConstruction(TFunction<void()>& Construct);
+	bool ProcessPendingWidgetConstruction(float DeltaTime);
+
 	typedef TArray<TSharedPtr<FUIExtensionPoint>> FExtensionPointList;
 	TMap<FGameplayTag, FExtensionPointList> ExtensionPointMap;
 
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
+
+	// Parent chains of every tag we've matched against, so we don't go back to the tag manager for every registration.
+	TMap<FGameplayTag, TArray<FGameplayTag>> TagLineageCache;
+
+	// Extensions registered inside a batch that haven't been announced yet.
+	FExtensionList PendingAddedExtensions;
+	int32 ExtensionBatchDepth = 0;
+
+	struct FPendingWidgetConstruction
+	{
+		TWeakObjectPtr<UObject> Owner;
+		FUIExtensionHandle ExtensionHandle;
+		TFunction<void()> Construct;
+	};
+
+	// Widget construction waiting for a frame with budget, in request order.
+	TArray<FPendingWidgetConstruction> PendingWidgetConstruction;
+	FTSTicker::FDelegateHandle WidgetConstructionTickHandle;
+
+	uint64 BudgetFrameNumber = 0;
+	double BudgetUsedSeconds = 0.0;
+
+	int32 NumWidgetsConstructed = 0;
+	int32 NumWidgetsDeferred = 0;
+	int32 MaxPendingWidgetConstruction = 0;
+	double TotalWidgetConstructionSeconds = 0.0;
+	double MaxFrameWidgetConstructionSeconds = 0.0;
+};
+
+/**
+ * Batches the extensions registered during its lifetime, see UUIExtensionSubsystem::BeginExtensionBatch.
+ */
+struct FScopedUIExtensionBatch : public FNoncopyable
+{
+	explicit FScopedUIExtensionBatch(UUIExtensionSubsystem* InSubsystem)
+		: Subsystem(InSubsystem)
+	{
+		if (UUIExtensionSubsystem* SubsystemPtr = Subsystem.Get())
+		{
+			SubsystemPtr->BeginExtensionBatch();
+		}
+	}
+
+	~FScopedUIExtensionBatch()
+	{
+		if (UUIExtensionSubsystem* SubsystemPtr = Subsystem.Get())
+		{
+			SubsystemPtr->EndExtensionBatch();
+		}
+	}
+
+private:
+	TWeakObjectPtr<UUIExtensionSubsystem> Subsystem;
 };
 
 
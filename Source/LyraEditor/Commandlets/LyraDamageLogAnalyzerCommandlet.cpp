@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraDamageLogAnalyzerCommandlet.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Weapons/LyraDamageEventRecorder.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraDamageLogAnalyzerCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogLyraDamageLogAnalyzer, Log, All);
+
+ULyraDamageLogAnalyzerCommandlet::ULyraDamageLogAnalyzerCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 ULyraDamageLogAnalyzerCommandlet::Main(const FString& FullCommandLine)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Params;
+	ParseCommandLine(*FullCommandLine, Tokens, Switches, Params);
+
+	TArray<FString> LogFiles;
+	if (const FString* LogParam = Params.Find(TEXT("Log")))
+	{
+		LogFiles.Add(*LogParam);
+	}
+	else
+	{
+		const FString LogDirectory = FLyraDamageEventLog::GetLogDirectory();
+		IFileManager::Get().FindFiles(LogFiles, *(LogDirectory / TEXT("*.ldmg")), /*Files=*/ true, /*Directories=*/ false);
+		for (FString& LogFile : LogFiles)
+		{
+			LogFile = LogDirectory / LogFile;
+		}
+	}
+
+	if (LogFiles.IsEmpty())
+	{
+		UE_LOG(LogLyraDamageLogAnalyzer, Error, TEXT("No damage logs to analyze, record some with Lyra.DamageLog.Enabled=1 or pass -Log=<file>"));
+		return 1;
+	}
+
+	const FString* EngagementGapParam = Params.Find(TEXT("EngagementGap"));
+	const double EngagementGap = EngagementGapParam ? FCString::Atod(**EngagementGapParam) : 2.0;
+
+	WeaponStats.Reset();
+
+	int64 NumEvents = 0;
+	for (const FString& LogFile : LogFiles)
+	{
+		FLyraDamageEventLog Log;
+		if (!Log.LoadFromFile(LogFile))
+		{
+			UE_LOG(LogLyraDamageLogAnalyzer, Warning, TEXT("Skipping %s, it could not be read"), *LogFile);
+			continue;
+		}
+
+		UE_LOG(LogLyraDamageLogAnalyzer, Display, TEXT("%s: %d events"), *LogFile, Log.Events.Num());
+		NumEvents += Log.Events.Num();
+		AnalyzeLog(Log, EngagementGap);
+	}
+
+	WeaponStats.ValueSort([](const FWeaponStats& A, const FWeaponStats& B) { return A.TotalDamage > B.TotalDamage; });
+
+	TArray<FString> CSVLines;
+	CSVLines.Add(TEXT("Weapon,Hits,Damage,AvgDamagePerHit,AvgDistance,DPS,Kills,AvgTTK,MedianTTK"));
+
+	UE_LOG(LogLyraDamageLogAnalyzer, Display, TEXT("%lld events from %d logs, engagement gap %.2fs"), NumEvents, LogFiles.Num(), EngagementGap);
+	for (TPair<FString, FWeaponStats>& Pair : WeaponStats)
+	{
+		FWeaponStats& Stats = Pair.Value;
+
+		const double AvgDamagePerHit = (Stats.NumHits > 0) ? (Stats.TotalDamage / Stats.NumHits) : 0.0;
+		const double AvgDistance = (Stats.NumHits > 0) ? (Stats.TotalDistance / Stats.NumHits) : 0.0;
+		const double DPS = (Stats.EngagementSeconds > 0.0) ? (Stats.EngagementDamage / Stats.EngagementSeconds) : 0.0;
+
+		double AvgTTK = 0.0;
+		double MedianTTK = 0.0;
+		if (Stats.TimesToKill.Num() > 0)
+		{
+			Stats.TimesToKill.Sort();
+			for (double TTK : Stats.TimesToKill)
+			{
+				AvgTTK += TTK;
+			}
+			AvgTTK /= Stats.TimesToKill.Num();
+			MedianTTK = Stats.TimesToKill[Stats.TimesToKill.Num() / 2];
+		}
+
+		UE_LOG(LogLyraDamageLogAnalyzer, Display, TEXT("  %s: %lld hits, %.0f damage (%.1f/hit at %.0fcm), %.1f DPS, %d kills, TTK avg %.2fs median %.2fs"),
+			*Pair.Key, Stats.NumHits, Stats.TotalDamage, AvgDamagePerHit, AvgDistance, DPS, Stats.TimesToKill.Num(), AvgTTK, MedianTTK);
+
+		CSVLines.Add(FString::Printf(TEXT("%s,%lld,%.2f,%.2f,%.2f,%.2f,%d,%.3f,%.3f"),
+			*Pair.Key, Stats.NumHits, Stats.TotalDamage, AvgDamagePerHit, AvgDistance, DPS, Stats.TimesToKill.Num(), AvgTTK, MedianTTK));
+	}
+
+	if (const FString* CSVParam = Params.Find(TEXT("CSV")))
+	{
+		if (!FFileHelper::SaveStringArrayToFile(CSVLines, **CSVParam))
+		{
+			UE_LOG(LogLyraDamageLogAnalyzer, Error, TEXT("Failed to write %s"), **CSVParam);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void ULyraDamageLogAnalyzerCommandlet::AnalyzeLog(const FLyraDamageEventLog& Log, double EngagementGap)
+{
+	struct FEngagement
+	{
+		double FirstHitTime = 0.0;
+		double LastHitTime = 0.0;
+		double Damage = 0.0;
+		int32 NumHits = 0;
+	};
+
+	auto CloseEngagement = [](FWeaponStats& Stats, const FEngagement& Engagement)
+	{
+		if (Engagement.NumHits > 1)
+		{
+			Stats.EngagementDamage += Engagement.Damage;
+			Stats.EngagementSeconds += Engagement.LastHitTime - Engagement.FirstHitTime;
+		}
+	};
+
+	// Instigator, target, weapon
+	using FEngagementKey = TTuple<uint32, uint32, uint32>;
+	TMap<FEngagementKey, FEngagement> Engagements;
+
+	// Time each target first took damage in its current life
+	TMap<uint32, double> TargetFirstDamageTimes;
+
+	for (const FLyraDamageEventLogEntry& Entry : Log.Events)
+	{
+		FWeaponStats& Stats = WeaponStats.FindOrAdd(Log.GetName(Entry.WeaponNameId));
+		++Stats.NumHits;
+		Stats.TotalDamage += Entry.Damage;
+		Stats.TotalDistance += Entry.Distance;
+
+		FEngagement& Engagement = Engagements.FindOrAdd(FEngagementKey(Entry.InstigatorNameId, Entry.TargetNameId, Entry.WeaponNameId));
+		if ((Engagement.NumHits > 0) && ((Entry.Time - Engagement.LastHitTime) > EngagementGap))
+		{
+			CloseEngagement(Stats, Engagement);
+			Engagement = FEngagement();
+		}
+		if (Engagement.NumHits == 0)
+		{
+			Engagement.FirstHitTime = Entry.Time;
+		}
+		Engagement.LastHitTime = Entry.Time;
+		Engagement.Damage += Entry.Damage;
+		++Engagement.NumHits;
+
+		const double FirstDamageTime = TargetFirstDamageTimes.FindOrAdd(Entry.TargetNameId, Entry.Time);
+		if (Entry.IsElimination())
+		{
+			Stats.TimesToKill.Add(Entry.Time - FirstDamageTime);
+			TargetFirstDamageTimes.Remove(Entry.TargetNameId);
+		}
+	}
+
+	for (const TPair<FEngagementKey, FEngagement>& Pair : Engagements)
+	{
+		CloseEngagement(WeaponStats.FindChecked(Log.GetName(Pair.Key.Get<2>())), Pair.Value);
+	}
+}
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "LyraDamageLogAnalyzerCommandlet.generated.h"
+
+struct FLyraDamageEventLog;
+
+/**
+ * Aggregates damage logs recorded by ULyraDamageEventRecorder into per-weapon balancing statistics.
+ *
+ * Usage: -run=LyraDamageLogAnalyzer [-Log=<file>] [-EngagementGap=<seconds>] [-CSV=<file>]
+ *	-Log            A single damage log to analyze, by default every log in Saved/DamageLogs is used
+ *	-EngagementGap  Hits from the same instigator on the same target with the same weapon closer together than this count as one engagement for DPS (default 2)
+ *	-CSV            Also write the statistics to this file
+ */
+UCLASS()
+class ULyraDamageLogAnalyzerCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+
+private:
+	struct FWeaponStats
+	{
+		int64 NumHits = 0;
+		double TotalDamage = 0.0;
+		double TotalDistance = 0.0;
+
+		// Damage and time spent in engagements of at least two hits, used for DPS
+		double EngagementDamage = 0.0;
+		double EngagementSeconds = 0.0;
+
+		// Time from the first damage a target took in its life to its elimination, for eliminations by this weapon
+		TArray<double> TimesToKill;
+	};
+
+	void AnalyzeLog(const FLyraDamageEventLog& Log, double EngagementGap);
+
+	TMap<FString, FWeaponStats> WeaponStats;
+};
@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraAbilityCost.h"
+
+#include "LyraGameplayAbility.h"
+#include "ScalableFloat.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityCost)
+
+int32 ULyraAbilityCost::GetQuantityAtAbilityLevel(const FScalableFloat& Quantity, const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo)
+{
+	// Getting the ability level means finding the spec on the ability system component, skip it for flat costs
+	if (Quantity.IsStatic())
+	{
+		return FMath::TruncToInt(Quantity.GetValueAtLevel(0.0f));
+	}
+
+	const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
+	return FMath::TruncToInt(Quantity.GetValueAtLevel(AbilityLevel));
+}
@@ -8,6 +8,7 @@
 #include "LyraAbilityCost.generated.h"
 
 class ULyraGameplayAbility;
+struct FScalableFloat;
 
 /**
  * ULyraAbilityCost
@@ -53,6 +54,10 @@ public:
 	/** If true, this cost should only be applied if this ability hits successfully */
 	bool ShouldOnlyApplyCostOnHit() const { return bOnlyApplyCostOnHit; }
 
+protected:
+	/** Evaluates Quantity at the ability's level, truncated to a whole amount. The level is only looked up when the quantity actually scales with it */
+	static int32 GetQuantityAtAbilityLevel(const FScalableFloat& Quantity, const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo);
+
 protected:
 	/** If true, this cost should only be applied if this ability hits successfully */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Costs)
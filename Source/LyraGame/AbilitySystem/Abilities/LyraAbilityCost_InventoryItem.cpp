@@ -6,7 +6,6 @@
 #include "GameplayAbilitySpecHandle.h"
 #include "Inventory/LyraInventoryManagerComponent.h"
 #include "GameFramework/Controller.h"
-#include "Math/UnrealMathUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityCost_InventoryItem)
 
@@ -15,19 +14,31 @@ ULyraAbilityCost_InventoryItem::ULyraAbilityCost_InventoryItem()
 	Quantity.SetValue(1.0f);
 }
 
-bool ULyraAbilityCost_InventoryItem::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+ULyraInventoryManagerComponent* ULyraAbilityCost_InventoryItem::FindInventoryComponent(const ULyraGameplayAbility* Ability) const
 {
-	if (AController* PC = Ability->GetControllerFromActorInfo())
+	AController* PC = Ability->GetControllerFromActorInfo();
+	if (PC == nullptr)
 	{
-		if (ULyraInventoryManagerComponent* InventoryComponent = PC->GetComponentByClass<ULyraInventoryManagerComponent>())
-		{
-			const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
+		return nullptr;
+	}
 
-			const float NumItemsToConsumeReal = Quantity.GetValueAtLevel(AbilityLevel);
-			const int32 NumItemsToConsume = FMath::TruncToInt(NumItemsToConsumeReal);
+	// Controllers keep their inventory, so only search their components when the controller changes
+	if ((CachedController.Get() != PC) || !CachedInventoryComponent.IsValid())
+	{
+		CachedController = PC;
+		CachedInventoryComponent = PC->GetComponentByClass<ULyraInventoryManagerComponent>();
+	}
 
-			return InventoryComponent->GetTotalItemCountByDefinition(ItemDefinition) >= NumItemsToConsume;
-		}
+	return CachedInventoryComponent.Get();
+}
+
+bool ULyraAbilityCost_InventoryItem::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (ULyraInventoryManagerComponent* InventoryComponent = FindInventoryComponent(Ability))
+	{
+		const int32 NumItemsToConsume = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
+
+		return InventoryComponent->GetTotalItemCountByDefinition(ItemDefinition) >= NumItemsToConsume;
 	}
 	return false;
 }
@@ -36,17 +47,11 @@ void ULyraAbilityCost_InventoryItem::ApplyCost(const ULyraGameplayAbility* Abili
 {
 	if (ActorInfo->IsNetAuthority())
 	{
-		if (AController* PC = Ability->GetControllerFromActorInfo())
+		if (ULyraInventoryManagerComponent* InventoryComponent = FindInventoryComponent(Ability))
 		{
-			if (ULyraInventoryManagerComponent* InventoryComponent = PC->GetComponentByClass<ULyraInventoryManagerComponent>())
-			{
-				const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
-
-				const float NumItemsToConsumeReal = Quantity.GetValueAtLevel(AbilityLevel);
-				const int32 NumItemsToConsume = FMath::TruncToInt(NumItemsToConsumeReal);
+			const int32 NumItemsToConsume = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
 
-				InventoryComponent->ConsumeItemsByDefinition(ItemDefinition, NumItemsToConsume);
-			}
+			InventoryComponent->ConsumeItemsByDefinition(ItemDefinition, NumItemsToConsume);
 		}
 	}
 }
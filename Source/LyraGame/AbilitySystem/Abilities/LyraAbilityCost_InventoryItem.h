@@ -11,8 +11,10 @@
 struct FGameplayAbilityActivationInfo;
 struct FGameplayAbilitySpecHandle;
 
+class AController;
 class ULyraGameplayAbility;
 class ULyraInventoryItemDefinition;
+class ULyraInventoryManagerComponent;
 class UObject;
 struct FGameplayAbilityActorInfo;
 struct FGameplayTagContainer;
@@ -34,6 +36,8 @@ public:
 	//~End of ULyraAbilityCost interface
 
 protected:
+	ULyraInventoryManagerComponent* FindInventoryComponent(const ULyraGameplayAbility* Ability) const;
+
 	/** How much of the item to spend (keyed on ability level) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=AbilityCost)
 	FScalableFloat Quantity;
@@ -41,4 +45,9 @@ protected:
 	/** Which item to consume */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=AbilityCost)
 	TSubclassOf<ULyraInventoryItemDefinition> ItemDefinition;
+
+private:
+	// Inventory of the last controller this cost was paid from
+	mutable TWeakObjectPtr<AController> CachedController;
+	mutable TWeakObjectPtr<ULyraInventoryManagerComponent> CachedInventoryComponent;
 };
@@ -3,58 +3,97 @@
 #include "LyraAbilityCost_ItemTagStack.h"
 
 #include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Engine/World.h"
 #include "Equipment/LyraEquipmentInstance.h"
 #include "Equipment/LyraGameplayAbility_FromEquipment.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "Inventory/LyraInventoryItemInstance.h"
+#include "LyraGameplayAbility.h"
+#include "LyraLogChannels.h"
 #include "NativeGameplayTags.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityCost_ItemTagStack)
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_ABILITY_FAIL_COST, "Ability.ActivateFail.Cost");
 
+namespace LyraConsoleVariables
+{
+	static bool bCacheCostItemInstances = true;
+	static FAutoConsoleVariableRef CVarCacheCostItemInstances(
+		TEXT("Lyra.AbilityCost.CacheItemInstances"),
+		bCacheCostItemInstances,
+		TEXT("If true, item tag stack costs remember the item they resolved for a spec instead of searching the ability specs on every check and apply"),
+		ECVF_Default);
+}
+
 ULyraAbilityCost_ItemTagStack::ULyraAbilityCost_ItemTagStack()
 {
 	Quantity.SetValue(1.0f);
 	FailureTag = TAG_ABILITY_FAIL_COST;
 }
 
-bool ULyraAbilityCost_ItemTagStack::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+ULyraInventoryItemInstance* ULyraAbilityCost_ItemTagStack::FindItemInstance(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const
 {
-	// Cost checks happen in pre-activation paths; don't assume the ability is instantiated.
-	if (!Ability || !ActorInfo)
+	const ULyraGameplayAbility_FromEquipment* EquipmentAbility = Cast<const ULyraGameplayAbility_FromEquipment>(Ability);
+	if (!EquipmentAbility)
 	{
-		return false;
+		return nullptr;
+	}
+
+	UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
+
+	if (LyraConsoleVariables::bCacheCostItemInstances && ASC && (CachedSpecHandle == Handle) && (CachedAbilitySystemComponent.Get() == ASC))
+	{
+		if (ULyraInventoryItemInstance* ItemInstance = CachedItemInstance.Get())
+		{
+			return ItemInstance;
+		}
 	}
 
 	ULyraInventoryItemInstance* ItemInstance = nullptr;
 
-	if (const ULyraGameplayAbility_FromEquipment* EquipmentAbility = Cast<const ULyraGameplayAbility_FromEquipment>(Ability))
+	// Prefer resolving from the spec instead of using GetCurrentAbilitySpec(), which is invalid on the CDO.
+	if (ASC)
 	{
-		// Prefer resolving from the spec instead of using GetCurrentAbilitySpec(), which is invalid on the CDO.
-		if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
+		if (const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Handle))
 		{
-			if (const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Handle))
+			if (ULyraEquipmentInstance* Equipment = Cast<ULyraEquipmentInstance>(Spec->SourceObject.Get()))
 			{
-				if (ULyraEquipmentInstance* Equipment = Cast<ULyraEquipmentInstance>(Spec->SourceObject.Get()))
-				{
-					ItemInstance = Cast<ULyraInventoryItemInstance>(Equipment->GetInstigator());
-				}
+				ItemInstance = Cast<ULyraInventoryItemInstance>(Equipment->GetInstigator());
 			}
 		}
+	}
 
-		// Fallback: if the ability is instantiated, the helper can work.
-		if (!ItemInstance)
-		{
-			ItemInstance = EquipmentAbility->GetAssociatedItem();
-		}
+	// Fallback: if the ability is instantiated, the helper can work.
+	if (!ItemInstance)
+	{
+		ItemInstance = EquipmentAbility->GetAssociatedItem();
 	}
 
-	if (ItemInstance)
+	if (ItemInstance && ASC)
 	{
-		const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
+		CachedAbilitySystemComponent = ASC;
+		CachedSpecHandle = Handle;
+		CachedItemInstance = ItemInstance;
+	}
 
-		const float NumStacksReal = Quantity.GetValueAtLevel(AbilityLevel);
-		const int32 NumStacks = FMath::TruncToInt(NumStacksReal);
+	return ItemInstance;
+}
+
+bool ULyraAbilityCost_ItemTagStack::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	// Cost checks happen in pre-activation paths; don't assume the ability is instantiated.
+	if (!Ability || !ActorInfo)
+	{
+		return false;
+	}
+
+	if (ULyraInventoryItemInstance* ItemInstance = FindItemInstance(Ability, Handle, ActorInfo))
+	{
+		const int32 NumStacks = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
 		const bool bCanApplyCost = ItemInstance->GetStatTagStackCount(Tag) >= NumStacks;
 
 		// Inform other abilities why this cost cannot be applied
@@ -72,17 +111,128 @@ void ULyraAbilityCost_ItemTagStack::ApplyCost(const ULyraGameplayAbility* Abilit
 {
 	if (ActorInfo->IsNetAuthority())
 	{
-		if (const ULyraGameplayAbility_FromEquipment* EquipmentAbility = Cast<const ULyraGameplayAbility_FromEquipment>(Ability))
+		// Usually just checked by the same commit, so this is the cached item
+		if (ULyraInventoryItemInstance* ItemInstance = FindItemInstance(Ability, Handle, ActorInfo))
+		{
+			const int32 NumStacks = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
+
+			ItemInstance->RemoveStatTagStack(Tag, NumStacks);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs CVarBenchmarkAbilityCosts(
+	TEXT("Lyra.BenchmarkAbilityCosts"),
+	TEXT("Times CheckCost and check-then-apply commits of every item tag stack cost on the local player's abilities, with and without cached item instances. Spent stacks are given back after every apply. Usage: Lyra.BenchmarkAbilityCosts [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Args, UWorld* World)
+{
+	const int32 Iterations = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	ULyraAbilitySystemComponent* ASC = PC ? Cast<ULyraAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC->GetPawn())) : nullptr;
+	if (ASC == nullptr)
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Lyra.BenchmarkAbilityCosts: the local player has no Lyra ability system component"));
+		return;
+	}
+
+	struct FCostToTime
+	{
+		ULyraGameplayAbility* Ability;
+		FGameplayAbilitySpecHandle Handle;
+		ULyraAbilityCost_ItemTagStack* Cost;
+	};
+
+	TArray<FCostToTime> CostsToTime;
+	for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+	{
+		// Instanced abilities check their own cost objects, the CDO's are used otherwise
+		ULyraGameplayAbility* Ability = Cast<ULyraGameplayAbility>(AbilitySpec.GetPrimaryInstance() ? AbilitySpec.GetPrimaryInstance() : AbilitySpec.Ability.Get());
+		if (Ability == nullptr)
+		{
+			continue;
+		}
+
+		for (const TObjectPtr<ULyraAbilityCost>& AdditionalCost : Ability->GetAdditionalCosts())
 		{
-			if (ULyraInventoryItemInstance* ItemInstance = EquipmentAbility->GetAssociatedItem())
+			if (ULyraAbilityCost_ItemTagStack* ItemTagStackCost = Cast<ULyraAbilityCost_ItemTagStack>(AdditionalCost))
 			{
-				const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
+				CostsToTime.Add({ Ability, AbilitySpec.Handle, ItemTagStackCost });
+			}
+		}
+	}
+
+	if (CostsToTime.IsEmpty())
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Lyra.BenchmarkAbilityCosts: none of the local player's abilities have item tag stack costs"));
+		return;
+	}
 
-				const float NumStacksReal = Quantity.GetValueAtLevel(AbilityLevel);
-				const int32 NumStacks = FMath::TruncToInt(NumStacksReal);
+	const FGameplayAbilityActorInfo* ActorInfo = ASC->AbilityActorInfo.Get();
+	const bool bCanApply = ActorInfo->IsNetAuthority();
 
-				ItemInstance->RemoveStatTagStack(Tag, NumStacks);
+	auto RunCheckPass = [&]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FCostToTime& CostToTime : CostsToTime)
+			{
+				CostToTime.Cost->CheckCost(CostToTime.Ability, CostToTime.Handle, ActorInfo, nullptr);
 			}
 		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	auto RunCommitPass = [&]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FCostToTime& CostToTime : CostsToTime)
+			{
+				ULyraInventoryItemInstance* ItemInstance = CostToTime.Cost->FindItemInstance(CostToTime.Ability, CostToTime.Handle, ActorInfo);
+				if (ItemInstance && CostToTime.Cost->CheckCost(CostToTime.Ability, CostToTime.Handle, ActorInfo, nullptr))
+				{
+					const int32 NumStacksBefore = ItemInstance->GetStatTagStackCount(CostToTime.Cost->GetTag());
+					CostToTime.Cost->ApplyCost(CostToTime.Ability, CostToTime.Handle, ActorInfo, FGameplayAbilityActivationInfo());
+					ItemInstance->AddStatTagStack(CostToTime.Cost->GetTag(), NumStacksBefore - ItemInstance->GetStatTagStackCount(CostToTime.Cost->GetTag()));
+				}
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const bool bPreviousCacheItemInstances = LyraConsoleVariables::bCacheCostItemInstances;
+
+	LyraConsoleVariables::bCacheCostItemInstances = false;
+	const double UncachedCheckSeconds = RunCheckPass();
+	const double UncachedCommitSeconds = bCanApply ? RunCommitPass() : 0.0;
+
+	LyraConsoleVariables::bCacheCostItemInstances = true;
+	const double CachedCheckSeconds = RunCheckPass();
+	const double CachedCommitSeconds = bCanApply ? RunCommitPass() : 0.0;
+
+	LyraConsoleVariables::bCacheCostItemInstances = bPreviousCacheItemInstances;
+
+	const double NumCalls = double(Iterations) * CostsToTime.Num();
+	UE_LOG(LogLyraAbilitySystem, Display, TEXT("Lyra.BenchmarkAbilityCosts: %d costs on %d abilities. CheckCost: %.0f/s uncached, %.0f/s cached"),
+		CostsToTime.Num(), ASC->GetActivatableAbilities().Num(), NumCalls / UncachedCheckSeconds, NumCalls / CachedCheckSeconds);
+
+	if (bCanApply)
+	{
+		UE_LOG(LogLyraAbilitySystem, Display, TEXT("Lyra.BenchmarkAbilityCosts: CheckCost+ApplyCost: %.0f/s uncached, %.0f/s cached"),
+			NumCalls / UncachedCommitSeconds, NumCalls / CachedCommitSeconds);
 	}
-}
+	else
+	{
+		UE_LOG(LogLyraAbilitySystem, Display, TEXT("Lyra.BenchmarkAbilityCosts: ApplyCost only runs with authority, skipped"));
+	}
+}));
+
+#endif // !UE_BUILD_SHIPPING
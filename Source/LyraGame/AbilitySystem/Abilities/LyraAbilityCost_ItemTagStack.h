@@ -11,7 +11,9 @@
 struct FGameplayAbilityActivationInfo;
 struct FGameplayAbilitySpecHandle;
 
+class UAbilitySystemComponent;
 class ULyraGameplayAbility;
+class ULyraInventoryItemInstance;
 class UObject;
 struct FGameplayAbilityActorInfo;
 
@@ -32,6 +34,11 @@ public:
 	virtual void ApplyCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) override;
 	//~End of ULyraAbilityCost interface
 
+	/** Returns the item instance that pays for this cost when used by the specified ability spec */
+	ULyraInventoryItemInstance* FindItemInstance(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const;
+
+	FGameplayTag GetTag() const { return Tag; }
+
 protected:
 	/** How much of the tag to spend (keyed on ability level) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Costs)
@@ -44,4 +51,12 @@ protected:
 	/** Which tag to send back as a response if this cost cannot be applied */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Costs)
 	FGameplayTag FailureTag;
+
+private:
+	// Item found for the last spec this cost was checked or applied for, so a commit (and every shot of an
+	// automatic weapon after it) doesn't have to search the spec list again. Specs keep their source object
+	// for their whole life and handles are never reused, so the handle is enough to know the item is current.
+	mutable TWeakObjectPtr<UAbilitySystemComponent> CachedAbilitySystemComponent;
+	mutable FGameplayAbilitySpecHandle CachedSpecHandle;
+	mutable TWeakObjectPtr<ULyraInventoryItemInstance> CachedItemInstance;
 };
@@ -13,19 +13,29 @@ ULyraAbilityCost_PlayerTagStack::ULyraAbilityCost_PlayerTagStack()
 	Quantity.SetValue(1.0f);
 }
 
-bool ULyraAbilityCost_PlayerTagStack::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+ALyraPlayerState* ULyraAbilityCost_PlayerTagStack::FindPlayerState(const ULyraGameplayAbility* Ability, const FGameplayAbilityActorInfo* ActorInfo) const
 {
+	// Lyra's ability system components live on the player state, which saves walking up to the controller
+	if (ALyraPlayerState* PS = Cast<ALyraPlayerState>(ActorInfo->OwnerActor.Get()))
+	{
+		return PS;
+	}
+
 	if (AController* PC = Ability->GetControllerFromActorInfo())
 	{
-		if (ALyraPlayerState* PS = Cast<ALyraPlayerState>(PC->PlayerState))
-		{
-			const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
+		return Cast<ALyraPlayerState>(PC->PlayerState);
+	}
 
-			const float NumStacksReal = Quantity.GetValueAtLevel(AbilityLevel);
-			const int32 NumStacks = FMath::TruncToInt(NumStacksReal);
+	return nullptr;
+}
 
-			return PS->GetStatTagStackCount(Tag) >= NumStacks;
-		}
+bool ULyraAbilityCost_PlayerTagStack::CheckCost(const ULyraGameplayAbility* Ability, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (ALyraPlayerState* PS = FindPlayerState(Ability, ActorInfo))
+	{
+		const int32 NumStacks = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
+
+		return PS->GetStatTagStackCount(Tag) >= NumStacks;
 	}
 	return false;
 }
@@ -34,17 +44,11 @@ void ULyraAbilityCost_PlayerTagStack::ApplyCost(const ULyraGameplayAbility* Abil
 {
 	if (ActorInfo->IsNetAuthority())
 	{
-		if (AController* PC = Ability->GetControllerFromActorInfo())
+		if (ALyraPlayerState* PS = FindPlayerState(Ability, ActorInfo))
 		{
-			if (ALyraPlayerState* PS = Cast<ALyraPlayerState>(PC->PlayerState))
-			{
-				const int32 AbilityLevel = Ability->GetAbilityLevel(Handle, ActorInfo);
-
-				const float NumStacksReal = Quantity.GetValueAtLevel(AbilityLevel);
-				const int32 NumStacks = FMath::TruncToInt(NumStacksReal);
+			const int32 NumStacks = GetQuantityAtAbilityLevel(Quantity, Ability, Handle, ActorInfo);
 
-				PS->RemoveStatTagStack(Tag, NumStacks);
-			}
+			PS->RemoveStatTagStack(Tag, NumStacks);
 		}
 	}
 }
@@ -11,6 +11,7 @@
 struct FGameplayAbilityActivationInfo;
 struct FGameplayAbilitySpecHandle;
 
+class ALyraPlayerState;
 class ULyraGameplayAbility;
 class UObject;
 struct FGameplayAbilityActorInfo;
@@ -32,6 +33,8 @@ public:
 	//~End of ULyraAbilityCost interface
 
 protected:
+	ALyraPlayerState* FindPlayerState(const ULyraGameplayAbility* Ability, const FGameplayAbilityActorInfo* ActorInfo) const;
+
 	/** How much of the tag to spend (keyed on ability level) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Costs)
 	FScalableFloat Quantity;
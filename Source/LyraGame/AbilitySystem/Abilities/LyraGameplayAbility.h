@@ -118,6 +118,7 @@ public:
 
 	ELyraAbilityActivationPolicy GetActivationPolicy() const { return ActivationPolicy; }
 	ELyraAbilityActivationGroup GetActivationGroup() const { return ActivationGroup; }
+	TConstArrayView<TObjectPtr<ULyraAbilityCost>> GetAdditionalCosts() const { return AdditionalCosts; }
 
 	void TryActivateAbilityOnSpawn(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) const;
 
@@ -5,10 +5,12 @@
 #include "LyraGameplayTags.h"
 #include "Net/UnrealNetwork.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Character/LyraBlockHealthLogicComponent.h"
 #include "Engine/World.h"
 #include "GameplayEffectExtension.h"
 #include "Messages/LyraVerbMessage.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "Weapons/LyraDamageEventRecorder.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraHealthSet)
 
@@ -114,14 +116,20 @@ void ULyraHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackD
 			MessageSystem.BroadcastMessage(Message.Verb, Message);
 		}
 
-		// Convert into -Health and then clamp
-		SetHealth(FMath::Clamp(GetHealth() - GetDamage(), MinimumHealth, GetMaxHealth()));
+		// Convert into -Health, quantize into blocks if the avatar uses them, and then clamp (self destructs always kill)
+		const float DamagedHealth = GetHealth() - GetDamage();
+		SetHealth(FMath::Clamp(bIsDamageFromSelfDestruct ? DamagedHealth : ApplyBlockHealthRules(GetHealth(), DamagedHealth), MinimumHealth, GetMaxHealth()));
 		SetDamage(0.0f);
+
+		if (Data.EvaluatedData.Magnitude > 0.0f)
+		{
+			ULyraDamageEventRecorder::RecordDamage(GetWorld(), Data.EffectSpec, GetOwningActor(), Data.EvaluatedData.Magnitude, (GetHealth() <= 0.0f) && !bOutOfHealth);
+		}
 	}
 	else if (Data.EvaluatedData.Attribute == GetHealingAttribute())
 	{
-		// Convert into +Health and then clamo
-		SetHealth(FMath::Clamp(GetHealth() + GetHealing(), MinimumHealth, GetMaxHealth()));
+		// Convert into +Health, quantize into blocks if the avatar uses them, and then clamp
+		SetHealth(FMath::Clamp(ApplyBlockHealthRules(GetHealth(), GetHealth() + GetHealing()), MinimumHealth, GetMaxHealth()));
 		SetHealing(0.0f);
 	}
 	else if (Data.EvaluatedData.Attribute == GetHealthAttribute())
@@ -146,6 +154,29 @@ void ULyraHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackD
 	bOutOfHealth = (GetHealth() <= 0.0f);
 }
 
+float ULyraHealthSet::ApplyBlockHealthRules(float OldHealth, float NewHealth) const
+{
+	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	const AActor* Avatar = ASC ? ASC->GetAvatarActor_Direct() : nullptr;
+	if (Avatar == nullptr)
+	{
+		return NewHealth;
+	}
+
+	if (BlockHealthAvatar.Get() != Avatar)
+	{
+		BlockHealthAvatar = Avatar;
+		BlockHealthLogic = Avatar->FindComponentByClass<ULyraBlockHealthLogicComponent>();
+	}
+
+	if (const ULyraBlockHealthLogicComponent* Logic = BlockHealthLogic.Get())
+	{
+		return Logic->QuantizeHealthChange(OldHealth, NewHealth, GetMaxHealth());
+	}
+
+	return NewHealth;
+}
+
 void ULyraHealthSet::PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& NewValue) const
 {
 	Super::PreAttributeBaseChange(Attribute, NewValue);
@@ -8,6 +8,8 @@
 
 #include "LyraHealthSet.generated.h"
 
+class AActor;
+class ULyraBlockHealthLogicComponent;
 class UObject;
 struct FFrame;
 
@@ -60,6 +62,9 @@ protected:
 
 	void ClampAttribute(const FGameplayAttribute& Attribute, float& NewValue) const;
 
+	// Applies the avatar's block health rules (if it has a ULyraBlockHealthLogicComponent) to a health change
+	float ApplyBlockHealthRules(float OldHealth, float NewHealth) const;
+
 private:
 
 	// The current health attribute.  The health will be capped by the max health attribute.  Health is hidden from modifiers so only executions can modify it.
@@ -73,6 +78,10 @@ private:
 	// Used to track when the health reaches 0.
 	bool bOutOfHealth;
 
+	// Block health rules of the current avatar, looked up again when the avatar changes
+	mutable TWeakObjectPtr<const AActor> BlockHealthAvatar;
+	mutable TWeakObjectPtr<const ULyraBlockHealthLogicComponent> BlockHealthLogic;
+
 	// -------------------------------------------------------------------
 	//	Meta Attribute (please keep attributes that aren't 'stateful' below 
 	// -------------------------------------------------------------------
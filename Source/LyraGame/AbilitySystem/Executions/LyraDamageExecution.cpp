@@ -85,49 +85,60 @@ void ULyraDamageExecution::Execute_Implementation(const FGameplayEffectCustomExe
 		}
 	}
 
-	// Apply rules for team damage/self damage/etc...
-	float DamageInteractionAllowedMultiplier = 0.0f;
-	if (HitActor)
+	// Area damage applied through ULyraAreaDamageLibrary already evaluated the team, distance and surface rules for this target
+	float DamageMultiplier = 0.0f;
+	if (TypedContext->HasPrecomputedDamageMultiplier())
 	{
-		ULyraTeamSubsystem* TeamSubsystem = HitActor->GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
-		if (ensure(TeamSubsystem))
+		DamageMultiplier = TypedContext->PrecomputedDamageMultiplier;
+	}
+	else
+	{
+		// Apply rules for team damage/self damage/etc...
+		float DamageInteractionAllowedMultiplier = 0.0f;
+		if (HitActor)
 		{
-			DamageInteractionAllowedMultiplier = TeamSubsystem->CanCauseDamage(EffectCauser, HitActor) ? 1.0 : 0.0;
+			ULyraTeamSubsystem* TeamSubsystem = HitActor->GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
+			if (ensure(TeamSubsystem))
+			{
+				DamageInteractionAllowedMultiplier = TeamSubsystem->CanCauseDamage(EffectCauser, HitActor) ? 1.0 : 0.0;
+			}
 		}
-	}
 
-	// Determine distance
-	double Distance = WORLD_MAX;
+		// Determine distance
+		double Distance = WORLD_MAX;
 
-	if (TypedContext->HasOrigin())
-	{
-		Distance = FVector::Dist(TypedContext->GetOrigin(), ImpactLocation);
-	}
-	else if (EffectCauser)
-	{
-		Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
-	}
-	else
-	{
-		ensureMsgf(false, TEXT("Damage Calculation cannot deduce a source location for damage coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(Spec.Def));
-	}
+		if (TypedContext->HasOrigin())
+		{
+			Distance = FVector::Dist(TypedContext->GetOrigin(), ImpactLocation);
+		}
+		else if (EffectCauser)
+		{
+			Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
+		}
+		else
+		{
+			ensureMsgf(false, TEXT("Damage Calculation cannot deduce a source location for damage coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(Spec.Def));
+		}
 
-	// Apply ability source modifiers
-	float PhysicalMaterialAttenuation = 1.0f;
-	float DistanceAttenuation = 1.0f;
-	if (const ILyraAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
-	{
-		if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+		// Apply ability source modifiers
+		float PhysicalMaterialAttenuation = 1.0f;
+		float DistanceAttenuation = 1.0f;
+		if (const ILyraAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
 		{
-			PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+			if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+			{
+				PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+			}
+
+			DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
 		}
+		DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
 
-		DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
+		DamageMultiplier = DistanceAttenuation * PhysicalMaterialAttenuation * DamageInteractionAllowedMultiplier;
 	}
-	DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
 
 	// Clamping is done when damage is converted to -health
-	const float DamageDone = FMath::Max(BaseDamage * DistanceAttenuation * PhysicalMaterialAttenuation * DamageInteractionAllowedMultiplier, 0.0f);
+	const float DamageDone = FMath::Max(BaseDamage * DamageMultiplier, 0.0f);
 
 	if (DamageDone > 0.0f)
 	{
@@ -4,6 +4,7 @@
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
 #include "LyraAbilitySystemComponent.h"
+#include "LyraGameplayCueManager.h"
 #include "LyraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilitySet)
@@ -80,6 +81,12 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 		return;
 	}
 
+	// Start loading the cues these abilities can fire now rather than when they are first used (listen servers and standalone)
+	if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+	{
+		GCM->PreloadCuesForAbilitySet(this, SourceObject ? SourceObject : LyraASC);
+	}
+
 	// Grant the gameplay abilities.
 	for (int32 AbilityIndex = 0; AbilityIndex < GrantedGameplayAbilities.Num(); ++AbilityIndex)
 	{
@@ -3,10 +3,12 @@
 #include "LyraAbilitySystemComponent.h"
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
+#include "AbilitySystemGlobals.h"
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
 #include "Animation/LyraAnimInstance.h"
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "LyraGlobalAbilitySystem.h"
 #include "LyraLogChannels.h"
 #include "System/LyraAssetManager.h"
@@ -16,6 +18,16 @@
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_AbilityInputBlocked, "Gameplay.AbilityInputBlocked");
 
+namespace LyraConsoleVariables
+{
+	static bool bUseInputTagIndex = true;
+	static FAutoConsoleVariableRef CVarUseInputTagIndex(
+		TEXT("Lyra.AbilityInput.UseInputTagIndex"),
+		bUseInputTagIndex,
+		TEXT("If true, ability input events look abilities up through an input tag index instead of scanning every activatable ability"),
+		ECVF_Default);
+}
+
 ULyraAbilitySystemComponent::ULyraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -204,16 +216,83 @@ void ULyraAbilitySystemComponent::AbilitySpecInputReleased(FGameplayAbilitySpec&
 	}
 }
 
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	bInputTagIndexDirty = true;
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnRemoveAbility(AbilitySpec);
+
+	bInputTagIndexDirty = true;
+}
+
+void ULyraAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Specs may have changed in place (including their dynamic tags), not just been added or removed
+	bInputTagIndexDirty = true;
+}
+
+void ULyraAbilitySystemComponent::RebuildInputTagIndex()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraASC_RebuildInputTagIndex);
+
+	for (TPair<FGameplayTag, TArray<FGameplayAbilitySpecHandle>>& Pair : InputTagToSpecHandles)
+	{
+		Pair.Value.Reset();
+	}
+
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	{
+		if (AbilitySpec.Ability)
+		{
+			for (const FGameplayTag& SourceTag : AbilitySpec.GetDynamicSpecSourceTags())
+			{
+				InputTagToSpecHandles.FindOrAdd(SourceTag).Add(AbilitySpec.Handle);
+			}
+		}
+	}
+
+	bInputTagIndexDirty = false;
+}
+
+const TArray<FGameplayAbilitySpecHandle>* ULyraAbilitySystemComponent::FindSpecHandlesForInputTag(const FGameplayTag& InputTag)
+{
+	if (bInputTagIndexDirty)
+	{
+		RebuildInputTagIndex();
+	}
+
+	return InputTagToSpecHandles.Find(InputTag);
+}
+
 void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraASC_AbilityInputTagPressed);
+
 	if (InputTag.IsValid())
 	{
+		if (LyraConsoleVariables::bUseInputTagIndex)
+		{
+			if (const TArray<FGameplayAbilitySpecHandle>* SpecHandles = FindSpecHandlesForInputTag(InputTag))
+			{
+				InputPressedSpecHandles.Append(*SpecHandles);
+				InputHeldSpecHandles.Append(*SpecHandles);
+			}
+			return;
+		}
+
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag)))
 			{
-				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+				InputPressedSpecHandles.Add(AbilitySpec.Handle);
+				InputHeldSpecHandles.Add(AbilitySpec.Handle);
 			}
 		}
 	}
@@ -221,13 +300,28 @@ void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Inp
 
 void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraASC_AbilityInputTagReleased);
+
 	if (InputTag.IsValid())
 	{
+		if (LyraConsoleVariables::bUseInputTagIndex)
+		{
+			if (const TArray<FGameplayAbilitySpecHandle>* SpecHandles = FindSpecHandlesForInputTag(InputTag))
+			{
+				for (const FGameplayAbilitySpecHandle& SpecHandle : *SpecHandles)
+				{
+					InputReleasedSpecHandles.Add(SpecHandle);
+					InputHeldSpecHandles.Remove(SpecHandle);
+				}
+			}
+			return;
+		}
+
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag)))
 			{
-				InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
+				InputReleasedSpecHandles.Add(AbilitySpec.Handle);
 				InputHeldSpecHandles.Remove(AbilitySpec.Handle);
 			}
 		}
@@ -236,14 +330,16 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 
 void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGamePaused)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraASC_ProcessAbilityInput);
+
 	if (HasMatchingGameplayTag(TAG_Gameplay_AbilityInputBlocked))
 	{
 		ClearAbilityInput();
 		return;
 	}
 
-	static TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
-	AbilitiesToActivate.Reset();
+	// Held abilities are only queued for WhileInputActive and pressed ones for OnInputTriggered, so the two sets can't overlap
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> AbilitiesToActivate;
 
 	//
 	// Process all abilities that activate when the input is held.
@@ -257,7 +353,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 				const ULyraGameplayAbility* LyraAbilityCDO = CastChecked<ULyraGameplayAbility>(AbilitySpec->Ability);
 				if (LyraAbilityCDO->GetActivationPolicy() == ELyraAbilityActivationPolicy::WhileInputActive)
 				{
-					AbilitiesToActivate.AddUnique(AbilitySpec->Handle);
+					AbilitiesToActivate.Add(AbilitySpec->Handle);
 				}
 			}
 		}
@@ -282,7 +378,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 					const ULyraGameplayAbility* LyraAbilityCDO = CastChecked<ULyraGameplayAbility>(AbilitySpec->Ability);
 					if (LyraAbilityCDO->GetActivationPolicy() == ELyraAbilityActivationPolicy::OnInputTriggered)
 					{
-						AbilitiesToActivate.AddUnique(AbilitySpec->Handle);
+						AbilitiesToActivate.Add(AbilitySpec->Handle);
 					}
 				}
 			}
@@ -292,24 +388,23 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	// Try to activate all queued abilities (presses + holds)
 	for (const FGameplayAbilitySpecHandle& AbilitySpecHandle : AbilitiesToActivate)
 	{
-		const FGameplayAbilitySpec* SpecBefore = FindAbilitySpecFromHandle(AbilitySpecHandle);
-		FString AbilityName = SpecBefore && SpecBefore->Ability ? SpecBefore->Ability->GetName() : TEXT("<Invalid>");
-		ELyraAbilityActivationPolicy Policy = SpecBefore && SpecBefore->Ability ? CastChecked<ULyraGameplayAbility>(SpecBefore->Ability)->GetActivationPolicy() : ELyraAbilityActivationPolicy::OnInputTriggered;
+		const bool bActivated = TryActivateAbility(AbilitySpecHandle);
 
-		bool bActivated = TryActivateAbility(AbilitySpecHandle);
-
-		const FGameplayAbilitySpec* SpecAfter = FindAbilitySpecFromHandle(AbilitySpecHandle);
-		bool bIsActiveNow = SpecAfter ? SpecAfter->IsActive() : false;
-		
-
-		if (!bActivated && !bIsActiveNow && SpecAfter && SpecAfter->Ability)
+#if !NO_LOGGING
+		// Re-running CanActivateAbility and building the strings is only worth it when someone is reading the log
+		if (!bActivated && UE_LOG_ACTIVE(LogLyra, Verbose))
 		{
-			FGameplayTagContainer FailureTags;
-			bool bCanActivate = SpecAfter->Ability->CanActivateAbility(AbilitySpecHandle, AbilityActorInfo.Get(), nullptr, nullptr, &FailureTags);
-			UE_LOG(LogLyra, Verbose,
-				TEXT("[LyraASC::ProcessAbilityInput] Activation failed Ability=%s CanActivateNow=%d FailureTags=%s"),
-				*AbilityName, bCanActivate ? 1 : 0, *FailureTags.ToString());
+			const FGameplayAbilitySpec* SpecAfter = FindAbilitySpecFromHandle(AbilitySpecHandle);
+			if (SpecAfter && SpecAfter->Ability && !SpecAfter->IsActive())
+			{
+				FGameplayTagContainer FailureTags;
+				const bool bCanActivate = SpecAfter->Ability->CanActivateAbility(AbilitySpecHandle, AbilityActorInfo.Get(), nullptr, nullptr, &FailureTags);
+				UE_LOG(LogLyra, Verbose,
+					TEXT("[LyraASC::ProcessAbilityInput] Activation failed Ability=%s CanActivateNow=%d FailureTags=%s"),
+					*SpecAfter->Ability->GetName(), bCanActivate ? 1 : 0, *FailureTags.ToString());
+			}
 		}
+#endif // !NO_LOGGING
 	}
 
 	//
@@ -575,3 +670,63 @@ float ULyraAbilitySystemComponent::GetCurrentAttributeValue(FGameplayAttribute A
 	}
 	return GetNumericAttribute(Attribute);
 }
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs CVarBenchmarkAbilityInput(
+	TEXT("Lyra.BenchmarkAbilityInput"),
+	TEXT("Times pressing and releasing every input tag bound on the local player's ability system component, scanning vs indexed. Abilities are not activated. Usage: Lyra.BenchmarkAbilityInput [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Args, UWorld* World)
+{
+	const int32 Iterations = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	ULyraAbilitySystemComponent* ASC = PC ? Cast<ULyraAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC->GetPawn())) : nullptr;
+	if (ASC == nullptr)
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Lyra.BenchmarkAbilityInput: the local player has no Lyra ability system component"));
+		return;
+	}
+
+	// Every dynamic source tag on a granted ability is treated as an input tag, like AbilityInputTagPressed does
+	FGameplayTagContainer InputTags;
+	for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+	{
+		InputTags.AppendTags(AbilitySpec.GetDynamicSpecSourceTags());
+	}
+
+	auto RunPass = [&]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FGameplayTag& InputTag : InputTags)
+			{
+				ASC->AbilityInputTagPressed(InputTag);
+				ASC->AbilityInputTagReleased(InputTag);
+			}
+			ASC->ClearAbilityInput();
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const bool bPreviousUseIndex = LyraConsoleVariables::bUseInputTagIndex;
+
+	LyraConsoleVariables::bUseInputTagIndex = false;
+	const double ScanSeconds = RunPass();
+
+	LyraConsoleVariables::bUseInputTagIndex = true;
+	const double IndexedSeconds = RunPass();
+
+	LyraConsoleVariables::bUseInputTagIndex = bPreviousUseIndex;
+
+	// One iteration is a frame where every bound input is pressed and released
+	UE_LOG(LogLyraAbilitySystem, Display, TEXT("Lyra.BenchmarkAbilityInput: %d abilities, %d input tags. Scan: %.2f us/frame. Indexed: %.2f us/frame"),
+		ASC->GetActivatableAbilities().Num(), InputTags.Num(),
+		(ScanSeconds * 1.0e6) / Iterations, (IndexedSeconds * 1.0e6) / Iterations);
+}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -90,6 +90,14 @@ protected:
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
+
+	/** Returns the handles of every ability bound to InputTag, rebuilding the index first if abilities changed */
+	const TArray<FGameplayAbilitySpecHandle>* FindSpecHandlesForInputTag(const FGameplayTag& InputTag);
+	void RebuildInputTagIndex();
+
 	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
 	virtual void NotifyAbilityFailed(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason) override;
 	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled) override;
@@ -108,13 +116,17 @@ protected:
 	TObjectPtr<ULyraAbilityTagRelationshipMapping> TagRelationshipMapping;
 
 	// Handles to abilities that had their input pressed this frame.
-	TArray<FGameplayAbilitySpecHandle> InputPressedSpecHandles;
+	TSet<FGameplayAbilitySpecHandle> InputPressedSpecHandles;
 
 	// Handles to abilities that had their input released this frame.
-	TArray<FGameplayAbilitySpecHandle> InputReleasedSpecHandles;
+	TSet<FGameplayAbilitySpecHandle> InputReleasedSpecHandles;
 
 	// Handles to abilities that have their input held.
-	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
+	TSet<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
+
+	// Abilities bound to each input tag (through their dynamic spec source tags), rebuilt lazily whenever abilities are given or removed.
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle>> InputTagToSpecHandles;
+	bool bInputTagIndexDirty = true;
 
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
@@ -2,12 +2,107 @@
 
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
 
+#include "GameplayTagsManager.h"
+#include "LyraLogChannels.h"
+#include "UObject/UObjectIterator.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityTagRelationshipMapping)
 
+namespace LyraConsoleVariables
+{
+	static bool bUseCompiledTagRelationships = true;
+	static FAutoConsoleVariableRef CVarUseCompiledTagRelationships(
+		TEXT("Lyra.AbilityTagRelationships.UseCompiled"),
+		bUseCompiledTagRelationships,
+		TEXT("If true, ability tag relationship queries use the table compiled on load instead of scanning every relationship"),
+		ECVF_Default);
+}
+
+void ULyraAbilityTagRelationshipMapping::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileRelationships();
+}
+
+#if WITH_EDITOR
+void ULyraAbilityTagRelationshipMapping::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileRelationships();
+}
+#endif
+
+void ULyraAbilityTagRelationshipMapping::CompileRelationships()
+{
+	CompiledRelationships.Reset();
+
+	for (const FLyraAbilityTagRelationship& Relationship : AbilityTagRelationships)
+	{
+		if (!Relationship.AbilityTag.IsValid())
+		{
+			continue;
+		}
+
+		FCompiledRelationship& Compiled = CompiledRelationships.FindOrAdd(Relationship.AbilityTag);
+		Compiled.AbilityTagsToBlock.AppendTags(Relationship.AbilityTagsToBlock);
+		Compiled.AbilityTagsToCancel.AppendTags(Relationship.AbilityTagsToCancel);
+		Compiled.ActivationRequiredTags.AppendTags(Relationship.ActivationRequiredTags);
+		Compiled.ActivationBlockedTags.AppendTags(Relationship.ActivationBlockedTags);
+	}
+
+	CompiledRelationships.Compact();
+}
+
+template <typename FuncType>
+void ULyraAbilityTagRelationshipMapping::ForEachMatchingRelationship(const FGameplayTagContainer& AbilityTags, FuncType&& Func) const
+{
+	if (CompiledRelationships.IsEmpty())
+	{
+		return;
+	}
+
+	// A relationship applies if the ability has its tag or a child of it (same as AbilityTags.HasTag), so walk up from each ability tag
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	TArray<const FCompiledRelationship*, TInlineAllocator<8>> Visited;
+
+	for (const FGameplayTag& AbilityTag : AbilityTags)
+	{
+		TSharedPtr<FGameplayTagNode> TagNode = TagsManager.FindTagNode(AbilityTag);
+		for (const FGameplayTagNode* Node = TagNode.Get(); (Node != nullptr) && Node->GetCompleteTag().IsValid(); Node = Node->GetParentTagNode())
+		{
+			if (const FCompiledRelationship* Compiled = CompiledRelationships.Find(Node->GetCompleteTag()))
+			{
+				if (!Visited.Contains(Compiled))
+				{
+					Visited.Add(Compiled);
+					Func(*Compiled);
+				}
+			}
+		}
+	}
+}
+
 void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const
 {
-	// Simple iteration for now
+	if (LyraConsoleVariables::bUseCompiledTagRelationships)
+	{
+		ForEachMatchingRelationship(AbilityTags, [OutTagsToBlock, OutTagsToCancel](const FCompiledRelationship& Compiled)
+			{
+				if (OutTagsToBlock)
+				{
+					OutTagsToBlock->AppendTags(Compiled.AbilityTagsToBlock);
+				}
+				if (OutTagsToCancel)
+				{
+					OutTagsToCancel->AppendTags(Compiled.AbilityTagsToCancel);
+				}
+			});
+		return;
+	}
+
+	// Scan every relationship (pre-compiled path, kept for comparison)
 	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
 	{
 		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
@@ -27,7 +122,23 @@ void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FG
 
 void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const
 {
-	// Simple iteration for now
+	if (LyraConsoleVariables::bUseCompiledTagRelationships)
+	{
+		ForEachMatchingRelationship(AbilityTags, [OutActivationRequired, OutActivationBlocked](const FCompiledRelationship& Compiled)
+			{
+				if (OutActivationRequired)
+				{
+					OutActivationRequired->AppendTags(Compiled.ActivationRequiredTags);
+				}
+				if (OutActivationBlocked)
+				{
+					OutActivationBlocked->AppendTags(Compiled.ActivationBlockedTags);
+				}
+			});
+		return;
+	}
+
+	// Scan every relationship (pre-compiled path, kept for comparison)
 	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
 	{
 		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
@@ -47,7 +158,13 @@ void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(con
 
 bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
 {
-	// Simple iteration for now
+	if (LyraConsoleVariables::bUseCompiledTagRelationships)
+	{
+		const FCompiledRelationship* Compiled = CompiledRelationships.Find(ActionTag);
+		return (Compiled != nullptr) && Compiled->AbilityTagsToCancel.HasAny(AbilityTags);
+	}
+
+	// Scan every relationship (pre-compiled path, kept for comparison)
 	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
 	{
 		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
@@ -61,3 +178,76 @@ bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplay
 	return false;
 }
 
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommand CVarBenchmarkTagRelationshipMapping(
+	TEXT("Lyra.BenchmarkTagRelationshipMapping"),
+	TEXT("Times activation tag queries against every loaded ability tag relationship mapping, scanning vs compiled. Usage: Lyra.BenchmarkTagRelationshipMapping [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Args)
+{
+	const int32 Iterations = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+	for (TObjectIterator<ULyraAbilityTagRelationshipMapping> It; It; ++It)
+	{
+		ULyraAbilityTagRelationshipMapping* Mapping = *It;
+		if (Mapping->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			continue;
+		}
+
+		// Use the child-most relationship tags as stand-ins for the ability tags of granted abilities
+		TArray<FGameplayTagContainer> AbilityTagSets;
+		for (const FLyraAbilityTagRelationship& Relationship : Mapping->GetAbilityTagRelationships())
+		{
+			AbilityTagSets.Add(FGameplayTagContainer(Relationship.AbilityTag));
+		}
+
+		if (AbilityTagSets.IsEmpty())
+		{
+			continue;
+		}
+
+		auto RunPass = [&]()
+		{
+			FGameplayTagContainer Required;
+			FGameplayTagContainer Blocked;
+			FGameplayTagContainer ToBlock;
+			FGameplayTagContainer ToCancel;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const FGameplayTagContainer& AbilityTags : AbilityTagSets)
+				{
+					Required.Reset();
+					Blocked.Reset();
+					ToBlock.Reset();
+					ToCancel.Reset();
+					Mapping->GetRequiredAndBlockedActivationTags(AbilityTags, &Required, &Blocked);
+					Mapping->GetAbilityTagsToBlockAndCancel(AbilityTags, &ToBlock, &ToCancel);
+				}
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		};
+
+		const bool bPreviousUseCompiled = LyraConsoleVariables::bUseCompiledTagRelationships;
+
+		LyraConsoleVariables::bUseCompiledTagRelationships = false;
+		const double ScanSeconds = RunPass();
+
+		LyraConsoleVariables::bUseCompiledTagRelationships = true;
+		const double CompiledSeconds = RunPass();
+
+		LyraConsoleVariables::bUseCompiledTagRelationships = bPreviousUseCompiled;
+
+		const double NumChecks = (double)Iterations * AbilityTagSets.Num();
+		UE_LOG(LogLyraAbilitySystem, Display, TEXT("Lyra.BenchmarkTagRelationshipMapping: %s (%d relationships). Scan: %.0f activation checks/s. Compiled: %.0f activation checks/s"),
+			*GetNameSafe(Mapping), AbilityTagSets.Num(),
+			NumChecks / FMath::Max(ScanSeconds, UE_DOUBLE_SMALL_NUMBER), NumChecks / FMath::Max(CompiledSeconds, UE_DOUBLE_SMALL_NUMBER));
+	}
+}));
+
+#endif // !UE_BUILD_SHIPPING
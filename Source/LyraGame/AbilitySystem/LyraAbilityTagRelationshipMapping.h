@@ -57,4 +57,33 @@ public:
 
 	/** Returns true if the specified ability tags are canceled by the passed in action tag */
 	bool IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const;
+
+	const TArray<FLyraAbilityTagRelationship>& GetAbilityTagRelationships() const { return AbilityTagRelationships; }
+
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
+	/** Rebuilds CompiledRelationships from AbilityTagRelationships */
+	void CompileRelationships();
+
+private:
+	/** All relationships sharing an AbilityTag, merged into one */
+	struct FCompiledRelationship
+	{
+		FGameplayTagContainer AbilityTagsToBlock;
+		FGameplayTagContainer AbilityTagsToCancel;
+		FGameplayTagContainer ActivationRequiredTags;
+		FGameplayTagContainer ActivationBlockedTags;
+	};
+
+	/** Calls Func for every compiled relationship that applies to AbilityTags (each tag and its parents) */
+	template <typename FuncType>
+	void ForEachMatchingRelationship(const FGameplayTagContainer& AbilityTags, FuncType&& Func) const;
+
+	/** AbilityTagRelationships keyed by AbilityTag, built on load */
+	TMap<FGameplayTag, FCompiledRelationship> CompiledRelationships;
 };
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraAreaDamage.h"
+
+#include "AbilitySystem/LyraAbilitySourceInterface.h"
+#include "AbilitySystem/LyraGameplayEffectContext.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "GameplayCueManager.h"
+#include "GameplayEffect.h"
+#include "LyraLogChannels.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Teams/LyraTeamSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAreaDamage)
+
+namespace LyraAreaDamage
+{
+	struct FPendingTarget
+	{
+		UAbilitySystemComponent* TargetASC;
+		const FHitResult* Hit;
+		float DamageMultiplier;
+	};
+}
+
+int32 ULyraAreaDamageLibrary::ApplyAreaDamage(UAbilitySystemComponent* SourceASC, TSubclassOf<UGameplayEffect> DamageEffect, float Level, FGameplayEffectContextHandle EffectContext, const TArray<FHitResult>& Hits)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraAreaDamage_ApplyAreaDamage);
+
+	if ((SourceASC == nullptr) || (DamageEffect == nullptr) || !SourceASC->IsOwnerActorAuthoritative() || Hits.IsEmpty())
+	{
+		return 0;
+	}
+
+	if (!EffectContext.IsValid())
+	{
+		EffectContext = SourceASC->MakeEffectContext();
+	}
+
+	const FLyraGameplayEffectContext* SourceContext = FLyraGameplayEffectContext::ExtractEffectContext(EffectContext);
+	if (SourceContext == nullptr)
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("ApplyAreaDamage: effect context for %s is not a FLyraGameplayEffectContext"), *GetNameSafe(DamageEffect));
+		return 0;
+	}
+
+	// Captures source attributes and tags once for the whole area
+	const FGameplayEffectSpecHandle SourceSpecHandle = SourceASC->MakeOutgoingSpec(DamageEffect, Level, EffectContext);
+	if (!SourceSpecHandle.IsValid())
+	{
+		return 0;
+	}
+	const FGameplayEffectSpec& SourceSpec = *SourceSpecHandle.Data.Get();
+	const FGameplayTagContainer* SourceTags = SourceSpec.CapturedSourceTags.GetAggregatedTags();
+
+	const AActor* EffectCauser = SourceContext->GetEffectCauser();
+	const ILyraAbilitySourceInterface* AbilitySource = SourceContext->GetAbilitySource();
+
+	FVector DamageOrigin = FVector::ZeroVector;
+	const bool bHasDamageOrigin = SourceContext->HasOrigin() || (EffectCauser != nullptr);
+	if (SourceContext->HasOrigin())
+	{
+		DamageOrigin = SourceContext->GetOrigin();
+	}
+	else if (EffectCauser)
+	{
+		DamageOrigin = EffectCauser->GetActorLocation();
+	}
+	else
+	{
+		ensureMsgf(false, TEXT("ApplyAreaDamage cannot deduce a source location for damage coming from %s; Falling back to WORLD_MAX dist!"), *GetNameSafe(DamageEffect));
+	}
+
+	// Source side of ULyraTeamSubsystem::CanCauseDamage
+	UWorld* World = SourceASC->GetWorld();
+	const ULyraTeamSubsystem* TeamSubsystem = World ? World->GetSubsystem<ULyraTeamSubsystem>() : nullptr;
+	const int32 InstigatorTeamId = TeamSubsystem ? TeamSubsystem->FindTeamFromObject(EffectCauser) : INDEX_NONE;
+	const ALyraPlayerState* InstigatorPlayerState = TeamSubsystem ? TeamSubsystem->FindPlayerStateFromActor(EffectCauser) : nullptr;
+
+	// Explosions usually hit a handful of teams and surfaces, so these are evaluated once each
+	TMap<int32, bool, TInlineSetAllocator<4>> CanDamageTeam;
+	TMap<const UPhysicalMaterial*, float, TInlineSetAllocator<8>> PhysicalMaterialAttenuations;
+
+	TSet<const UAbilitySystemComponent*, DefaultKeyFuncs<const UAbilitySystemComponent*>, TInlineSetAllocator<32>> SeenTargets;
+	TArray<LyraAreaDamage::FPendingTarget, TInlineAllocator<32>> PendingTargets;
+
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.HitObjectHandle.FetchActor();
+		UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor);
+		if ((TargetASC == nullptr) || SeenTargets.Contains(TargetASC))
+		{
+			continue;
+		}
+		SeenTargets.Add(TargetASC);
+
+		// Apply rules for team damage/self damage/etc...
+		float DamageInteractionAllowedMultiplier = 0.0f;
+		if (TeamSubsystem)
+		{
+			if ((HitActor == EffectCauser) || (TeamSubsystem->FindPlayerStateFromActor(HitActor) == InstigatorPlayerState))
+			{
+				DamageInteractionAllowedMultiplier = 1.0f;
+			}
+			else
+			{
+				const int32 TargetTeamId = TeamSubsystem->FindTeamFromObject(HitActor);
+				if (const bool* bCachedCanDamage = CanDamageTeam.Find(TargetTeamId))
+				{
+					DamageInteractionAllowedMultiplier = *bCachedCanDamage ? 1.0f : 0.0f;
+				}
+				else
+				{
+					// Targets without a team can be damaged by instigators that have one, as long as they have an ability system component (which they all do here)
+					const bool bCanDamage = (InstigatorTeamId != INDEX_NONE) && (TargetTeamId != InstigatorTeamId);
+					CanDamageTeam.Add(TargetTeamId, bCanDamage);
+					DamageInteractionAllowedMultiplier = bCanDamage ? 1.0f : 0.0f;
+				}
+			}
+		}
+		else
+		{
+			ensure(TeamSubsystem);
+		}
+
+		// Apply ability source modifiers
+		float PhysicalMaterialAttenuation = 1.0f;
+		float DistanceAttenuation = 1.0f;
+		if (AbilitySource)
+		{
+			const FGameplayTagContainer& TargetTags = TargetASC->GetOwnedGameplayTags();
+
+			// Cached per material, so this assumes the surface multiplier doesn't depend on the target's tags (true for ULyraRangedWeaponInstance)
+			if (const UPhysicalMaterial* PhysMat = Hit.PhysMaterial.Get())
+			{
+				if (const float* CachedAttenuation = PhysicalMaterialAttenuations.Find(PhysMat))
+				{
+					PhysicalMaterialAttenuation = *CachedAttenuation;
+				}
+				else
+				{
+					PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, &TargetTags);
+					PhysicalMaterialAttenuations.Add(PhysMat, PhysicalMaterialAttenuation);
+				}
+			}
+
+			const double Distance = bHasDamageOrigin ? FVector::Dist(DamageOrigin, Hit.ImpactPoint) : WORLD_MAX;
+			DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, &TargetTags);
+		}
+		DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
+
+		PendingTargets.Add({ TargetASC, &Hit, DistanceAttenuation * PhysicalMaterialAttenuation * DamageInteractionAllowedMultiplier });
+	}
+
+	// Gameplay cues triggered by the specs below are sent together when this goes out of scope
+	FScopedGameplayCueSendContext GameplayCueSendContext;
+
+	for (const LyraAreaDamage::FPendingTarget& PendingTarget : PendingTargets)
+	{
+		FGameplayEffectContextHandle TargetContextHandle = EffectContext.Duplicate();
+		TargetContextHandle.AddHitResult(*PendingTarget.Hit, /*bReset=*/ true);
+
+		FLyraGameplayEffectContext* TargetContext = FLyraGameplayEffectContext::ExtractEffectContext(TargetContextHandle);
+		check(TargetContext);
+		TargetContext->PrecomputedDamageMultiplier = PendingTarget.DamageMultiplier;
+
+		// Copying keeps the already captured source attributes, only the context differs per target
+		FGameplayEffectSpec TargetSpec(SourceSpec);
+		TargetSpec.SetContext(TargetContextHandle, /*bSkipRecaptureSourceActorTags=*/ true);
+
+		SourceASC->ApplyGameplayEffectSpecToTarget(TargetSpec, PendingTarget.TargetASC);
+	}
+
+	return PendingTargets.Num();
+}
@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayEffectTypes.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Templates/SubclassOf.h"
+
+#include "LyraAreaDamage.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+struct FHitResult;
+
+/**
+ * ULyraAreaDamageLibrary
+ *
+ *	Applies a damage effect (using ULyraDamageExecution) to many targets at once, e.g. for explosions.
+ *	Everything that only depends on the source (captured attributes, source tags, instigator team, damage origin)
+ *	is computed once, then each target's team, distance and physical material multiplier is evaluated in one pass
+ *	and handed to the execution through the effect context so it doesn't have to redo that work per target.
+ */
+UCLASS()
+class LYRAGAME_API ULyraAreaDamageLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Applies DamageEffect from SourceASC to the ability system component of every actor in Hits (server only).
+	 * Multiple hits on the same target only count once, the first one wins, so sort Hits by distance if that matters.
+	 * EffectContext should have its origin set to the center of the area, otherwise the effect causer's location is used.
+	 *
+	 * @return The number of targets the effect was applied to
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Lyra|Damage")
+	static int32 ApplyAreaDamage(UAbilitySystemComponent* SourceASC, TSubclassOf<UGameplayEffect> DamageEffect, float Level, FGameplayEffectContextHandle EffectContext, const TArray<FHitResult>& Hits);
+};
@@ -27,6 +27,20 @@ bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerialize(FArchive& Ar,
 
 	Ar << CartridgeID;
 
+	// Only the first hit of a cartridge carries the aim direction
+	uint8 bHasAimDir = !AimDir.IsZero();
+	Ar.SerializeBits(&bHasAimDir, 1);
+	if (bHasAimDir)
+	{
+		bool bAimDirSuccess = true;
+		AimDir.NetSerialize(Ar, Map, bAimDirSuccess);
+		bOutSuccess &= bAimDirSuccess;
+	}
+	else if (Ar.IsLoading())
+	{
+		AimDir = FVector::ZeroVector;
+	}
+
 	return true;
 }
 
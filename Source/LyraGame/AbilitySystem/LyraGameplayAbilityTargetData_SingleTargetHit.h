@@ -26,6 +26,10 @@ struct FLyraGameplayAbilityTargetData_SingleTargetHit : public FGameplayAbilityT
 	UPROPERTY()
 	int32 CartridgeID;
 
+	/** Aim direction of the cartridge before spread, lets the server regenerate the (seeded) pellet pattern. Only set on the first hit of a cartridge */
+	UPROPERTY()
+	FVector_NetQuantizeNormal AimDir = FVector::ZeroVector;
+
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 
 	virtual UScriptStruct* GetScriptStruct() const override
@@ -8,6 +8,9 @@
 #include "GameplayTagsManager.h"
 #include "UObject/UObjectThreadContext.h"
 #include "Async/Async.h"
+#include "AbilitySystem/LyraAbilitySet.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayEffect.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueManager)
 
@@ -34,7 +37,42 @@ namespace LyraGameplayCueManagerCvars
 		TEXT("Shows all assets that were loaded via LyraGameplayCueManager and are currently in memory."),
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
-	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
+	static FAutoConsoleCommand CVarDumpCuePreloadStats(
+		TEXT("Lyra.DumpGameplayCuePreloadStats"),
+		TEXT("Shows how far ahead of their first use gameplay cues were loaded, and which ones were still loading when they first fired."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpCuePreloadStats));
+
+	static int32 LoadMode = (int32)ELyraEditorLoadMode::LoadUpfront;
+	static FAutoConsoleVariableRef CVarLoadMode(
+		TEXT("Lyra.GameplayCues.LoadMode"),
+		LoadMode,
+		TEXT("How gameplay cues are loaded. Read when the cue manager starts up, so set it in an ini or with -dpcvars\n")
+		TEXT("0: Load all cues up front (default)\n")
+		TEXT("1: Preload as cue tags are referenced, except in the editor\n")
+		TEXT("2: Preload as cue tags are referenced"),
+		ECVF_ReadOnly);
+
+	static ELyraEditorLoadMode GetLoadMode()
+	{
+		return (ELyraEditorLoadMode)FMath::Clamp(LoadMode, (int32)ELyraEditorLoadMode::LoadUpfront, (int32)ELyraEditorLoadMode::PreloadAsCuesAreReferenced);
+	}
+
+	static bool bPredictivePreload = true;
+	static FAutoConsoleVariableRef CVarPredictivePreload(
+		TEXT("Lyra.GameplayCues.PredictivePreload"),
+		bPredictivePreload,
+		TEXT("When cues are delay loaded, async load the cues an ability set or weapon can fire as soon as it is granted or equipped"),
+		ECVF_Default);
+
+	static bool bSyncLoadMissingCues = false;
+	static FAutoConsoleVariableRef CVarSyncLoadMissingCues(
+		TEXT("Lyra.GameplayCues.SyncLoadMissing"),
+		bSyncLoadMissingCues,
+		TEXT("Synchronously load cues that fire before they are loaded instead of skipping them. The hitches show up in Lyra.DumpGameplayCuePreloadStats"),
+		ECVF_Default);
+
+	// How deep to look into struct and array properties when searching for cue tags
+	static constexpr int32 MaxCueTagSearchDepth = 3;
 }
 
 const bool bPreloadEvenInEditor = true;
@@ -94,7 +132,7 @@ void ULyraGameplayCueManager::LoadAlwaysLoadedCues()
 
 bool ULyraGameplayCueManager::ShouldAsyncLoadRuntimeObjectLibraries() const
 {
-	switch (LyraGameplayCueManagerCvars::LoadMode)
+	switch (LyraGameplayCueManagerCvars::GetLoadMode())
 	{
 	case ELyraEditorLoadMode::LoadUpfront:
 		return true;
@@ -115,7 +153,7 @@ bool ULyraGameplayCueManager::ShouldAsyncLoadRuntimeObjectLibraries() const
 
 bool ULyraGameplayCueManager::ShouldSyncLoadMissingGameplayCues() const
 {
-	return false;
+	return LyraGameplayCueManagerCvars::bSyncLoadMissingCues;
 }
 
 bool ULyraGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
@@ -177,6 +215,316 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
 }
 
+void ULyraGameplayCueManager::DumpCuePreloadStats(const TArray<FString>& Args)
+{
+	ULyraGameplayCueManager* GCM = Get();
+	if (!GCM)
+	{
+		UE_LOG(LogLyra, Error, TEXT("DumpCuePreloadStats failed. No ULyraGameplayCueManager found."));
+		return;
+	}
+
+	int32 NumFired = 0;
+	int32 NumReady = 0;
+	int32 NumSyncLoaded = 0;
+	double TotalLatency = 0.0;
+	double WorstLatency = 0.0;
+	double TotalSyncLoadSeconds = 0.0;
+
+	UE_LOG(LogLyra, Log, TEXT("=========== Dumping Gameplay Cue First Fires ==========="));
+	for (const TPair<FGameplayTag, FCuePreloadStats>& Pair : GCM->CuePreloadStats)
+	{
+		const FCuePreloadStats& Stats = Pair.Value;
+		if (Stats.FirstFireTime < 0.0)
+		{
+			continue;
+		}
+
+		++NumFired;
+		if (Stats.bReadyOnFirstFire)
+		{
+			++NumReady;
+			const double LeadTime = (Stats.PreloadCompleteTime >= 0.0) ? (Stats.FirstFireTime - Stats.PreloadCompleteTime) : -1.0;
+			UE_LOG(LogLyra, Log, TEXT("  ready   %s (predicted: %s, loaded %.2f s before use)"), *Pair.Key.ToString(),
+				(Stats.PreloadRequestTime >= 0.0) ? TEXT("yes") : TEXT("no"), LeadTime);
+			continue;
+		}
+
+		const double Latency = (Stats.FirstPlayableTime >= 0.0) ? (Stats.FirstPlayableTime - Stats.FirstFireTime) : -1.0;
+		if (Latency >= 0.0)
+		{
+			TotalLatency += Latency;
+			WorstLatency = FMath::Max(WorstLatency, Latency);
+		}
+
+		if (Stats.SyncLoadSeconds > 0.0)
+		{
+			++NumSyncLoaded;
+			TotalSyncLoadSeconds += Stats.SyncLoadSeconds;
+		}
+
+		UE_LOG(LogLyra, Log, TEXT("  MISSED  %s (predicted: %s, playable %.1f ms after first fire, sync load %.1f ms)"), *Pair.Key.ToString(),
+			(Stats.PreloadRequestTime >= 0.0) ? TEXT("yes") : TEXT("no"), Latency * 1000.0, Stats.SyncLoadSeconds * 1000.0);
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("=========== Gameplay Cue First Fire summary ==========="));
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cues fired, %d were loaded in time"), NumFired, NumReady);
+	UE_LOG(LogLyra, Log, TEXT("  ... %.1f ms average / %.1f ms worst latency for cues that were not"), (NumFired > NumReady) ? (TotalLatency * 1000.0 / (NumFired - NumReady)) : 0.0, WorstLatency * 1000.0);
+	UE_LOG(LogLyra, Log, TEXT("  ... %d synchronous cue loads, %.1f ms of hitches"), NumSyncLoaded, TotalSyncLoadSeconds * 1000.0);
+}
+
+void ULyraGameplayCueManager::RouteGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	if (!ShouldDelayLoadGameplayCues() || !IsInGameThread() || !GameplayCueTag.IsValid())
+	{
+		Super::RouteGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+		return;
+	}
+
+	FCuePreloadStats& Stats = CuePreloadStats.FindOrAdd(GameplayCueTag);
+	if (Stats.FirstFireTime >= 0.0)
+	{
+		Super::RouteGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+		return;
+	}
+
+	Stats.FirstFireTime = FPlatformTime::Seconds();
+	Stats.bReadyOnFirstFire = IsCueLoaded(GameplayCueTag);
+
+	Super::RouteGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+
+	if (!Stats.bReadyOnFirstFire)
+	{
+		// Either we just did a synchronous load inside the route, or the engine started an async load of the missing cue
+		if (IsCueLoaded(GameplayCueTag))
+		{
+			Stats.FirstPlayableTime = FPlatformTime::Seconds();
+			Stats.SyncLoadSeconds = Stats.FirstPlayableTime - Stats.FirstFireTime;
+
+			UE_LOG(LogLyra, Warning, TEXT("Gameplay cue %s was synchronously loaded on first use (%.2f ms)"), *GameplayCueTag.ToString(), Stats.SyncLoadSeconds * 1000.0);
+		}
+		else if (const int32* DataIdx = RuntimeGameplayCueObjectLibrary.CueSet ? RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Find(GameplayCueTag) : nullptr)
+		{
+			// Piggyback on the same load to find out when the cue becomes playable
+			const FSoftObjectPath CuePath = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData[*DataIdx].GameplayCueNotifyObj;
+			StreamableManager.RequestAsyncLoad(CuePath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnFirstFireCueLoaded, GameplayCueTag), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("GameplayCueManager"));
+		}
+	}
+}
+
+void ULyraGameplayCueManager::OnFirstFireCueLoaded(FGameplayTag Tag)
+{
+	if (FCuePreloadStats* Stats = CuePreloadStats.Find(Tag))
+	{
+		Stats->FirstPlayableTime = FPlatformTime::Seconds();
+	}
+}
+
+bool ULyraGameplayCueManager::IsCueLoaded(const FGameplayTag& Tag) const
+{
+	if (RuntimeGameplayCueObjectLibrary.CueSet)
+	{
+		if (const int32* DataIdx = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Find(Tag))
+		{
+			const FGameplayCueNotifyData& CueData = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData[*DataIdx];
+			return (CueData.LoadedGameplayCueClass != nullptr) || (CueData.GameplayCueNotifyObj.ResolveObject() != nullptr);
+		}
+	}
+
+	// Tags without a notify have nothing to load
+	return true;
+}
+
+void ULyraGameplayCueManager::PreloadCuesForAbilitySet(const ULyraAbilitySet* AbilitySet, UObject* OwningObject)
+{
+	if (!AbilitySet || !ShouldPredictivelyPreloadCues())
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraGameplayCueManager_PreloadCuesForAbilitySet);
+
+	FGameplayTagContainer CueTags;
+	for (const FLyraAbilitySet_GameplayAbility& AbilityToGrant : AbilitySet->GetGrantedGameplayAbilities())
+	{
+		if (AbilityToGrant.Ability)
+		{
+			CueTags.AppendTags(GetCueTagsForClass(AbilityToGrant.Ability));
+		}
+	}
+
+	for (const FLyraAbilitySet_GameplayEffect& EffectToGrant : AbilitySet->GetGrantedGameplayEffects())
+	{
+		if (EffectToGrant.GameplayEffect)
+		{
+			CueTags.AppendTags(GetCueTagsForClass(EffectToGrant.GameplayEffect));
+		}
+	}
+
+	PreloadCueTags(CueTags, OwningObject);
+}
+
+void ULyraGameplayCueManager::PreloadCuesForAbility(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OwningObject)
+{
+	if (AbilityClass && ShouldPredictivelyPreloadCues())
+	{
+		PreloadCueTags(GetCueTagsForClass(AbilityClass), OwningObject);
+	}
+}
+
+void ULyraGameplayCueManager::PreloadCueTags(const FGameplayTagContainer& CueTags, UObject* OwningObject)
+{
+	if (!RuntimeGameplayCueObjectLibrary.CueSet)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (const FGameplayTag& CueTag : CueTags)
+	{
+		if (!RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Contains(CueTag))
+		{
+			continue;
+		}
+
+		FCuePreloadStats& Stats = CuePreloadStats.FindOrAdd(CueTag);
+		if (Stats.PreloadRequestTime < 0.0)
+		{
+			Stats.PreloadRequestTime = Now;
+		}
+
+		// Goes through the same path as content referenced cues so the owner keeps it alive across map loads
+		ProcessTagToPreload(CueTag, OwningObject);
+	}
+}
+
+namespace LyraGameplayCueManagerCvars
+{
+	static void GatherCueTagsFromProperties(const UStruct* Struct, const void* Container, const FGameplayTag& CueRootTag, int32 Depth, FGameplayTagContainer& OutCueTags, TArray<const UClass*>& OutEffectClasses);
+
+	static void GatherCueTagsFromValue(const FProperty* Property, const void* ValuePtr, const FGameplayTag& CueRootTag, int32 Depth, FGameplayTagContainer& OutCueTags, TArray<const UClass*>& OutEffectClasses)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FGameplayTag::StaticStruct())
+			{
+				const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(ValuePtr);
+				if (Tag.MatchesTag(CueRootTag))
+				{
+					OutCueTags.AddTag(Tag);
+				}
+			}
+			else if (StructProperty->Struct == FGameplayTagContainer::StaticStruct())
+			{
+				const FGameplayTagContainer& Tags = *static_cast<const FGameplayTagContainer*>(ValuePtr);
+				OutCueTags.AppendTags(Tags.Filter(FGameplayTagContainer(CueRootTag)));
+			}
+			else if (Depth < MaxCueTagSearchDepth)
+			{
+				GatherCueTagsFromProperties(StructProperty->Struct, ValuePtr, CueRootTag, Depth + 1, OutCueTags, OutEffectClasses);
+			}
+		}
+		else if (const FClassProperty* ClassProperty = CastField<FClassProperty>(Property))
+		{
+			const UClass* Class = Cast<UClass>(ClassProperty->GetObjectPropertyValue(ValuePtr));
+			if (Class && Class->IsChildOf(UGameplayEffect::StaticClass()))
+			{
+				OutEffectClasses.AddUnique(Class);
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			if (Depth < MaxCueTagSearchDepth)
+			{
+				FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+				for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+				{
+					GatherCueTagsFromValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), CueRootTag, Depth + 1, OutCueTags, OutEffectClasses);
+				}
+			}
+		}
+	}
+
+	static void GatherCueTagsFromProperties(const UStruct* Struct, const void* Container, const FGameplayTag& CueRootTag, int32 Depth, FGameplayTagContainer& OutCueTags, TArray<const UClass*>& OutEffectClasses)
+	{
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+			{
+				GatherCueTagsFromValue(*It, It->ContainerPtrToValuePtr<void>(Container, ArrayIndex), CueRootTag, Depth, OutCueTags, OutEffectClasses);
+			}
+		}
+	}
+}
+
+const FGameplayTagContainer& ULyraGameplayCueManager::GetCueTagsForClass(const UClass* Class)
+{
+	check(Class);
+
+	if (const FGameplayTagContainer* CachedTags = CueTagsByClass.Find(Class))
+	{
+		return *CachedTags;
+	}
+
+	// Add first so effects that reference each other don't recurse forever
+	CueTagsByClass.Add(Class);
+
+	FGameplayTagContainer CueTags;
+	TArray<const UClass*> EffectClasses;
+
+	// Cue tags the class stores itself (e.g. a weapon ability's impact cue) plus any effect classes it can apply,
+	// cues fired with literal tags inside blueprint graphs can't be found this way and are still loaded on first use
+	const FGameplayTag CueRootTag = UGameplayCueSet::BaseGameplayCueTag();
+	LyraGameplayCueManagerCvars::GatherCueTagsFromProperties(Class, Class->GetDefaultObject(), CueRootTag, 0, CueTags, EffectClasses);
+
+	if (const UGameplayEffect* EffectCDO = Cast<UGameplayEffect>(Class->GetDefaultObject()))
+	{
+		for (const FGameplayEffectCue& EffectCue : EffectCDO->GameplayCues)
+		{
+			CueTags.AppendTags(EffectCue.GameplayCueTags);
+		}
+	}
+
+	for (const UClass* EffectClass : EffectClasses)
+	{
+		if (EffectClass != Class)
+		{
+			CueTags.AppendTags(GetCueTagsForClass(EffectClass));
+		}
+	}
+
+	FGameplayTagContainer& Result = CueTagsByClass.FindChecked(Class);
+	Result = MoveTemp(CueTags);
+	return Result;
+}
+
+bool ULyraGameplayCueManager::ShouldPredictivelyPreloadCues() const
+{
+	if (!LyraGameplayCueManagerCvars::bPredictivePreload || !ShouldDelayLoadGameplayCues())
+	{
+		return false;
+	}
+
+	// When everything is loaded up front there is nothing to predict
+	switch (LyraGameplayCueManagerCvars::GetLoadMode())
+	{
+	case ELyraEditorLoadMode::LoadUpfront:
+		return false;
+	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
+#if WITH_EDITOR
+		if (GIsEditor)
+		{
+			return false;
+		}
+#endif
+		break;
+	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced:
+		break;
+	}
+
+	return true;
+}
+
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
 {
 	FScopeLock ScopeLock(&LoadedGameplayTagsToProcessCS);
@@ -251,7 +599,7 @@ void ULyraGameplayCueManager::ProcessLoadedTags()
 
 void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject)
 {
-	switch (LyraGameplayCueManagerCvars::LoadMode)
+	switch (LyraGameplayCueManagerCvars::GetLoadMode())
 	{
 	case ELyraEditorLoadMode::LoadUpfront:
 		return;
@@ -290,6 +638,15 @@ void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObje
 
 void ULyraGameplayCueManager::OnPreloadCueComplete(FSoftObjectPath Path, TWeakObjectPtr<UObject> OwningObject, bool bAlwaysLoadedCue)
 {
+	const double Now = FPlatformTime::Seconds();
+	for (TPair<FGameplayTag, FCuePreloadStats>& Pair : CuePreloadStats)
+	{
+		if ((Pair.Value.PreloadRequestTime >= 0.0) && (Pair.Value.PreloadCompleteTime < 0.0) && IsCueLoaded(Pair.Key))
+		{
+			Pair.Value.PreloadCompleteTime = Now;
+		}
+	}
+
 	if (bAlwaysLoadedCue || OwningObject.IsValid())
 	{
 		if (UClass* LoadedGameplayCueClass = Cast<UClass>(Path.ResolveObject()))
@@ -357,7 +714,7 @@ void ULyraGameplayCueManager::UpdateDelayLoadDelegateListeners()
 	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 
-	switch (LyraGameplayCueManagerCvars::LoadMode)
+	switch (LyraGameplayCueManagerCvars::GetLoadMode())
 	{
 	case ELyraEditorLoadMode::LoadUpfront:
 		return;
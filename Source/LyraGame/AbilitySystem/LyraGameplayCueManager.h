@@ -8,6 +8,8 @@
 
 class FString;
 class UClass;
+class UGameplayAbility;
+class ULyraAbilitySet;
 class UObject;
 class UWorld;
 struct FObjectKey;
@@ -32,9 +34,17 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual void RouteGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
+	static void DumpCuePreloadStats(const TArray<FString>& Args);
+
+	// Async loads the cues the abilities and effects in this set can fire, kept alive for as long as OwningObject is
+	void PreloadCuesForAbilitySet(const ULyraAbilitySet* AbilitySet, UObject* OwningObject);
+
+	// Async loads the cues this ability can fire, kept alive for as long as OwningObject is
+	void PreloadCuesForAbility(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OwningObject);
 
 	// When delay loading cues, this will load the cues that must be always loaded anyway
 	void LoadAlwaysLoadedCues();
@@ -52,6 +62,12 @@ private:
 	void HandlePostLoadMap(UWorld* NewWorld);
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
+	bool ShouldPredictivelyPreloadCues() const;
+
+	void PreloadCueTags(const FGameplayTagContainer& CueTags, UObject* OwningObject);
+	const FGameplayTagContainer& GetCueTagsForClass(const UClass* Class);
+	bool IsCueLoaded(const FGameplayTag& Tag) const;
+	void OnFirstFireCueLoaded(FGameplayTag Tag);
 
 private:
 	struct FLoadedGameplayTagToProcessData
@@ -63,6 +79,17 @@ private:
 		FLoadedGameplayTagToProcessData(const FGameplayTag& InTag, const TWeakObjectPtr<UObject>& InWeakOwner) : Tag(InTag), WeakOwner(InWeakOwner) {}
 	};
 
+	// How a cue's first use went, collected on clients to see if predictive preloading gets cues in ahead of time
+	struct FCuePreloadStats
+	{
+		double PreloadRequestTime = -1.0;
+		double PreloadCompleteTime = -1.0;
+		double FirstFireTime = -1.0;
+		double FirstPlayableTime = -1.0;
+		double SyncLoadSeconds = 0.0;
+		bool bReadyOnFirstFire = false;
+	};
+
 private:
 	// Cues that were preloaded on the client due to being referenced by content
 	UPROPERTY(transient)
@@ -73,6 +100,12 @@ private:
 	UPROPERTY(transient)
 	TSet<TObjectPtr<UClass>> AlwaysLoadedCues;
 
+	// Cue tags an ability or effect class can fire, found by walking its default properties
+	TMap<FObjectKey, FGameplayTagContainer> CueTagsByClass;
+
+	// Game thread only
+	TMap<FGameplayTag, FCuePreloadStats> CuePreloadStats;
+
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
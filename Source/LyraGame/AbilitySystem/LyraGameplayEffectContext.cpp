@@ -32,6 +32,8 @@ bool FLyraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 
 	// Not serialized for post-activation use:
 	// CartridgeID
+	// BatchedImpacts
+	// PrecomputedDamageMultiplier
 
 	return true;
 }
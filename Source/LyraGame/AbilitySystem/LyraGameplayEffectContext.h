@@ -45,6 +45,8 @@ struct FLyraGameplayEffectContext : public FGameplayEffectContext
 			// Does a deep copy of the hit result
 			NewContext->AddHitResult(*GetHitResult(), true);
 		}
+		// The multiplier belongs to the one target it was computed for, effects made from a copy go through the full damage rules
+		NewContext->PrecomputedDamageMultiplier = -1.0f;
 		return NewContext;
 	}
 
@@ -59,11 +61,22 @@ struct FLyraGameplayEffectContext : public FGameplayEffectContext
 	/** Returns the physical material from the hit result if there is one */
 	const UPhysicalMaterial* GetPhysicalMaterial() const;
 
+	/** Returns true if the team, distance and surface multipliers were already combined by ULyraAreaDamageLibrary */
+	bool HasPrecomputedDamageMultiplier() const { return PrecomputedDamageMultiplier >= 0.0f; }
+
 public:
 	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
 	UPROPERTY()
 	int32 CartridgeID = -1;
 
+	/** Every impact of a batched weapon impact cue (see ULyraWeaponImpactSubsystem), the regular hit result holds the most significant one */
+	UPROPERTY()
+	TArray<FHitResult> BatchedImpacts;
+
+	/** Combined team/distance/physical material multiplier computed for this target by a batched area damage application, negative if not set. Not kept by Duplicate(). Server only */
+	UPROPERTY()
+	float PrecomputedDamageMultiplier = -1.0f;
+
 protected:
 	/** Ability Source object (should implement ILyraAbilitySourceInterface). NOT replicated currently */
 	UPROPERTY()
@@ -6,9 +6,17 @@
 #include "AbilitySystem/Attributes/LyraHealthSet.h"
 #include "Character/LyraHealthComponent.h"
 
+#include "AbilitySystemGlobals.h"
 #include "AbilitySystemInterface.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameplayEffect.h"
+#include "LyraGameplayTags.h"
 #include "Logging/LogMacros.h"
+#include "System/LyraAssetManager.h"
+#include "System/LyraGameData.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraBlockHealthLogicComponent)
 
@@ -25,20 +33,15 @@ void ULyraBlockHealthLogicComponent::BeginPlay()
 	Super::BeginPlay();
 
 	TryBindToHealthComponent();
-
-	if (bQuantizeOnBeginPlay)
-	{
-		QuantizeNow();
-	}
 }
 
 void ULyraBlockHealthLogicComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (HealthComponent)
+	if (ULyraHealthEventSubsystem* HealthEvents = UWorld::GetSubsystem<ULyraHealthEventSubsystem>(GetWorld()))
 	{
-		HealthComponent->OnHealthChanged.RemoveDynamic(this, &ThisClass::HandleHealthChanged);
-		HealthComponent->OnMaxHealthChanged.RemoveDynamic(this, &ThisClass::HandleMaxHealthChanged);
+		HealthEvents->RemoveComponentEventsConsumer(HealthComponent, HealthEventsHandle);
 	}
+	HealthEventsHandle.Reset();
 
 	HealthComponent = nullptr;
 
@@ -53,28 +56,8 @@ bool ULyraBlockHealthLogicComponent::IsServerAuthority() const
 
 void ULyraBlockHealthLogicComponent::QuantizeNow()
 {
-	if (!bEnableBlockHealth)
-	{
-		return;
-	}
-
-	if (!IsServerAuthority())
-	{
-		return;
-	}
-
-	if (!HealthComponent)
-	{
-		TryBindToHealthComponent();
-	}
-
-	if (!HealthComponent)
-	{
-		return;
-	}
-
-	// Force a health "change" into the quantizer. Use current health for both values.
-	ApplyQuantizedHealthIfNeeded(HealthComponent->GetHealth(), HealthComponent->GetHealth());
+	// Nothing to snap: every health change is quantized by ULyraHealthSet as it is applied.
+	// Rounding a partial block up here would heal the pawn (e.g. on spawn), so the current health is left alone.
 }
 
 void ULyraBlockHealthLogicComponent::TryBindToHealthComponent()
@@ -94,8 +77,10 @@ void ULyraBlockHealthLogicComponent::TryBindToHealthComponent()
 	HealthComponent = Owner->FindComponentByClass<ULyraHealthComponent>();
 	if (HealthComponent)
 	{
-		HealthComponent->OnHealthChanged.AddDynamic(this, &ThisClass::HandleHealthChanged);
-		HealthComponent->OnMaxHealthChanged.AddDynamic(this, &ThisClass::HandleMaxHealthChanged);
+		if (ULyraHealthEventSubsystem* HealthEvents = UWorld::GetSubsystem<ULyraHealthEventSubsystem>(Owner->GetWorld()))
+		{
+			HealthEventsHandle = HealthEvents->AddComponentEventsConsumer(HealthComponent, FLyraHealthEventBatchDelegate::FDelegate::CreateUObject(this, &ThisClass::HandleHealthEvents));
+		}
 
 		// Initial broadcast for UI.
 		const int32 Blocks = GetCurrentBlocks_Implementation();
@@ -172,6 +157,22 @@ float ULyraBlockHealthLogicComponent::GetBlocksNormalized_Implementation() const
 	return (MaxBlocks > 0) ? (static_cast<float>(GetCurrentBlocks_Implementation()) / static_cast<float>(MaxBlocks)) : 0.0f;
 }
 
+void ULyraBlockHealthLogicComponent::HandleHealthEvents(TConstArrayView<FLyraHealthEvent> Events)
+{
+	// Only our own health component's events, see TryBindToHealthComponent
+	for (const FLyraHealthEvent& Event : Events)
+	{
+		if (Event.Type == ELyraHealthEventType::HealthChanged)
+		{
+			HandleHealthChanged(Event.HealthComponent, Event.OldValue, Event.NewValue, Event.Instigator);
+		}
+		else if (Event.Type == ELyraHealthEventType::MaxHealthChanged)
+		{
+			HandleMaxHealthChanged(Event.HealthComponent, Event.OldValue, Event.NewValue, Event.Instigator);
+		}
+	}
+}
+
 void ULyraBlockHealthLogicComponent::HandleMaxHealthChanged(ULyraHealthComponent* InHealthComponent, float OldValue, float NewValue, AActor* Instigator)
 {
 	if (!bEnableBlockHealth || !InHealthComponent)
@@ -195,12 +196,9 @@ void ULyraBlockHealthLogicComponent::HandleHealthChanged(ULyraHealthComponent* I
 		return;
 	}
 
+	// The change was already quantized by ULyraHealthSet, this is only reporting it
 	const int32 OldBlocks = HealthToBlocks_RoundUp(OldValue);
-
-	ApplyQuantizedHealthIfNeeded(OldValue, NewValue);
-
-	const float FinalHealth = InHealthComponent->GetHealth();
-	const int32 NewBlocks = HealthToBlocks_RoundUp(FinalHealth);
+	const int32 NewBlocks = HealthToBlocks_RoundUp(NewValue);
 
 	if (OldBlocks != NewBlocks)
 	{
@@ -208,47 +206,13 @@ void ULyraBlockHealthLogicComponent::HandleHealthChanged(ULyraHealthComponent* I
 	}
 }
 
-void ULyraBlockHealthLogicComponent::ApplyQuantizedHealthIfNeeded(float OldHealth, float NewHealth)
+float ULyraBlockHealthLogicComponent::QuantizeHealthChange(float OldHealth, float NewHealth, float MaxHealth) const
 {
-	if (bApplyingQuantization)
-	{
-		return;
-	}
-
-	if (!bEnableBlockHealth)
-	{
-		return;
-	}
-
-	AActor* Owner = GetOwner();
-	if (!Owner || !Owner->HasAuthority())
+	if (!bEnableBlockHealth || (BlockSize <= KINDA_SMALL_NUMBER))
 	{
-		return;
-	}
-
-	if (!HealthComponent)
-	{
-		return;
+		return NewHealth;
 	}
 
-	ULyraAbilitySystemComponent* ASC = GetLyraASC();
-	if (!ASC)
-	{
-		return;
-	}
-
-	if (BlockSize <= KINDA_SMALL_NUMBER)
-	{
-		return;
-	}
-
-	// No delta -> nothing to do.
-	if (FMath::IsNearlyEqual(OldHealth, NewHealth))
-	{
-		return;
-	}
-
-	const float MaxHealth = HealthComponent->GetMaxHealth();
 	const float ClampedOld = FMath::Clamp(OldHealth, 0.0f, MaxHealth);
 	const float ClampedNew = FMath::Clamp(NewHealth, 0.0f, MaxHealth);
 
@@ -257,10 +221,10 @@ void ULyraBlockHealthLogicComponent::ApplyQuantizedHealthIfNeeded(float OldHealt
 
 	if (!bIsDamage && !bIsHealing)
 	{
-		return;
+		return NewHealth;
 	}
 
-	float QuantizedTargetHealth;
+	const int32 OldBlocks = HealthToBlocks_RoundUp(ClampedOld);
 
 	if (bIsDamage)
 	{
@@ -268,43 +232,61 @@ void ULyraBlockHealthLogicComponent::ApplyQuantizedHealthIfNeeded(float OldHealt
 		const int32 DamageBlocks = (DamageAmount <= TwoBlockDamageThreshold) ? 1 : 2;
 		const int32 ClampedDamageBlocks = FMath::Clamp(DamageBlocks, 1, FMath::Max(1, MaxDamageBlocksPerHit));
 
-		const int32 OldBlocks = HealthToBlocks_RoundUp(ClampedOld);
 		const int32 NewBlocks = FMath::Max(0, OldBlocks - ClampedDamageBlocks);
-		QuantizedTargetHealth = FMath::Clamp(BlocksToHealth(NewBlocks), 0.0f, MaxHealth);
+		return FMath::Clamp(BlocksToHealth(NewBlocks), 0.0f, MaxHealth);
 	}
 	else
 	{
 		const float HealAmount = ClampedNew - ClampedOld;
 		const int32 HealBlocks = FMath::Max(1, FMath::CeilToInt(HealAmount / BlockSize));
 
-		const int32 OldBlocks = HealthToBlocks_RoundUp(ClampedOld);
-		const int32 MaxBlocks = GetMaxBlocks_Implementation();
+		const int32 MaxBlocks = HealthToBlocks_RoundUp(MaxHealth);
 		const int32 NewBlocks = FMath::Min(MaxBlocks, OldBlocks + HealBlocks);
-		QuantizedTargetHealth = FMath::Clamp(BlocksToHealth(NewBlocks), 0.0f, MaxHealth);
+		return FMath::Clamp(BlocksToHealth(NewBlocks), 0.0f, MaxHealth);
 	}
+}
+
+//////////////////////////////////////////////////////////////////////
 
-	if (FMath::IsNearlyEqual(QuantizedTargetHealth, ClampedNew, 0.01f))
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs CVarCountHealthChangesPerHit(
+	TEXT("Lyra.BlockHealth.CountHealthChangesPerHit"),
+	TEXT("Damages the local player's pawn once and reports how many Health attribute changes the hit caused (block health should still only cause one). Usage: Lyra.BlockHealth.CountHealthChangesPerHit [Damage]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Args, UWorld* World)
+{
+	const float DamageAmount = (Args.Num() > 0) ? FCString::Atof(*Args[0]) : 10.0f;
+
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC ? PC->GetPawn() : nullptr);
+	if ((ASC == nullptr) || !ASC->IsOwnerActorAuthoritative())
 	{
+		UE_LOG(LogLyraBlockHealthLogic, Warning, TEXT("Lyra.BlockHealth.CountHealthChangesPerHit: needs a local player pawn with an ability system component, on the server"));
 		return;
 	}
 
-	// IMPORTANT: Lyra death flow is triggered by ULyraHealthSet::OnOutOfHealth, which is broadcast
-	// from ULyraHealthSet::PostGameplayEffectExecute (i.e. when damage/heal meta attributes are applied).
-	// Directly overriding Health via SetNumericAttributeBase can bypass that flow, leaving the pawn "alive"
-	// even if Health visually hits 0.
-	//
-	// So, when our quantization would drive health to 0, route it through the standard self-destruct damage GE.
-	if (QuantizedTargetHealth <= 0.0f)
+	const TSubclassOf<UGameplayEffect> DamageGE = ULyraAssetManager::GetSubclass(ULyraGameData::Get().DamageGameplayEffect_SetByCaller);
+	FGameplayEffectSpecHandle SpecHandle = DamageGE ? ASC->MakeOutgoingSpec(DamageGE, 1.0f, ASC->MakeEffectContext()) : FGameplayEffectSpecHandle();
+	if (!SpecHandle.IsValid())
 	{
-		// Avoid loops: DamageSelfDestruct applies damage, which will re-enter health change delegates.
-		bApplyingQuantization = true;
-		UE_LOG(LogLyraBlockHealthLogic, Verbose, TEXT("ApplyQuantizedHealthIfNeeded: quantized to 0 -> triggering Lyra death flow via DamageSelfDestruct for '%s'"), *GetNameSafe(Owner));
-		HealthComponent->DamageSelfDestruct(/*bFellOutOfWorld=*/ false);
-		bApplyingQuantization = false;
+		UE_LOG(LogLyraBlockHealthLogic, Warning, TEXT("Lyra.BlockHealth.CountHealthChangesPerHit: unable to find the damage gameplay effect"));
 		return;
 	}
+	SpecHandle.Data->SetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_Damage, DamageAmount);
 
-	bApplyingQuantization = true;
-	ASC->SetNumericAttributeBase(ULyraHealthSet::GetHealthAttribute(), QuantizedTargetHealth);
-	bApplyingQuantization = false;
-}
+	int32 NumHealthChanges = 0;
+	FOnGameplayAttributeValueChange& HealthChangeDelegate = ASC->GetGameplayAttributeValueChangeDelegate(ULyraHealthSet::GetHealthAttribute());
+	const FDelegateHandle CounterHandle = HealthChangeDelegate.AddLambda([&NumHealthChanges](const FOnAttributeChangeData&) { ++NumHealthChanges; });
+
+	const float OldHealth = ASC->GetNumericAttribute(ULyraHealthSet::GetHealthAttribute());
+	ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+	const float NewHealth = ASC->GetNumericAttribute(ULyraHealthSet::GetHealthAttribute());
+
+	HealthChangeDelegate.Remove(CounterHandle);
+
+	UE_LOG(LogLyraBlockHealthLogic, Display, TEXT("Lyra.BlockHealth.CountHealthChangesPerHit: %.1f damage took health from %.1f to %.1f in %d Health attribute change(s)"),
+		DamageAmount, OldHealth, NewHealth, NumHealthChanges);
+}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -4,6 +4,7 @@
 
 #include "Components/ActorComponent.h"
 #include "Character/LyraBlockHealthInterface.h"
+#include "Character/LyraHealthEventSubsystem.h"
 
 #include "LyraBlockHealthLogicComponent.generated.h"
 
@@ -19,8 +20,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FLyraBlockHealthLogic_BlocksChange
  * Drop-in addon for the existing ULyraHealthComponent created by ALyraCharacter.
  *
  * It doesn't modify ULyraHealthComponent (no new methods/vars there).
- * Instead it binds to ULyraHealthComponent delegates and enforces block-based rules
- * server-side by overriding the GAS Health attribute base value.
+ * The block rules are enforced server-side by ULyraHealthSet, which asks this component to quantize
+ * damage and healing as they are executed, so each hit still results in a single Health change.
+ * This component registers with the world's health event stream (ULyraHealthEventSubsystem) for its own
+ * health component to report block changes, so it also works for health components that don't broadcast
+ * their per-actor delegates.
  */
 UCLASS(Blueprintable, Meta = (BlueprintSpawnableComponent))
 class LYRAGAME_API ULyraBlockHealthLogicComponent : public UActorComponent, public ILyraBlockHealthInterface
@@ -50,9 +54,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Lyra|Health|Blocks")
 	FLyraBlockHealthLogic_BlocksChanged OnBlocksChanged;
 
-	/** Optional: set health to full blocks on BeginPlay/when found (useful if you want always-multiple-of-block). */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lyra|Health|Blocks")
-	bool bQuantizeOnBeginPlay = true;
+	/** No longer used: health is quantized by ULyraHealthSet as every change is applied, so there is nothing to snap on BeginPlay. */
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Health is quantized as it changes, there is nothing to do on BeginPlay."))
+	bool bQuantizeOnBeginPlay_DEPRECATED = true;
 
 public:
 	//~UActorComponent interface
@@ -66,10 +70,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Health|Blocks")
 	bool IsServerAuthority() const;
 
-	/** Force a re-quantization based on current health/max health. Server-only. */
-	UFUNCTION(BlueprintCallable, Category = "Lyra|Health|Blocks")
+	/** Deprecated, does nothing. Health is quantized by ULyraHealthSet on every change. */
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Health|Blocks", meta = (DeprecatedFunction, DeprecationMessage = "Health is quantized as it changes, there is nothing to snap."))
 	void QuantizeNow();
 
+	/** Returns the health a change from OldHealth to NewHealth results in under the block rules. Used by ULyraHealthSet when executing damage and healing. */
+	float QuantizeHealthChange(float OldHealth, float NewHealth, float MaxHealth) const;
+
 public:
 	// ILyraBlockHealthInterface
 	virtual bool IsBlockHealthEnabled_Implementation() const override { return bEnableBlockHealth; }
@@ -81,10 +88,8 @@ public:
 	virtual float GetBlocksNormalized_Implementation() const override;
 
 protected:
-	UFUNCTION()
+	void HandleHealthEvents(TConstArrayView<FLyraHealthEvent> Events);
 	void HandleHealthChanged(ULyraHealthComponent* InHealthComponent, float OldValue, float NewValue, AActor* Instigator);
-
-	UFUNCTION()
 	void HandleMaxHealthChanged(ULyraHealthComponent* InHealthComponent, float OldValue, float NewValue, AActor* Instigator);
 
 	void TryBindToHealthComponent();
@@ -93,12 +98,10 @@ protected:
 	int32 HealthToBlocks_RoundUp(float Health) const;
 	float BlocksToHealth(int32 Blocks) const;
 
-	void ApplyQuantizedHealthIfNeeded(float OldHealth, float NewHealth);
-
 private:
 	UPROPERTY(Transient)
 	TObjectPtr<ULyraHealthComponent> HealthComponent;
 
-	bool bApplyingQuantization = false;
+	FDelegateHandle HealthEventsHandle;
 };
 
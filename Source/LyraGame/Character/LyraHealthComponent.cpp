@@ -83,8 +83,15 @@ void ULyraHealthComponent::InitializeWithAbilitySystem(ULyraAbilitySystemCompone
 
 	ClearGameplayTags();
 
-	OnHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
-	OnMaxHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
+	HealthEventSubsystem = GetWorld()->GetSubsystem<ULyraHealthEventSubsystem>();
+
+	PushHealthEvent(ELyraHealthEventType::HealthChanged, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
+	PushHealthEvent(ELyraHealthEventType::MaxHealthChanged, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
+	if (bBroadcastAttributeChangeDelegates)
+	{
+		OnHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
+		OnMaxHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
+	}
 
 	//UGameFrameworkComponentManager::SendGameFrameworkComponentExtensionEvent(GetOwner(), UGameFrameworkComponentManager::NAME_HealthComponentReady);
 }
@@ -100,6 +107,21 @@ void ULyraHealthComponent::UninitializeFromAbilitySystem()
 
 	HealthSet = nullptr;
 	AbilitySystemComponent = nullptr;
+	HealthEventSubsystem = nullptr;
+}
+
+void ULyraHealthComponent::PushHealthEvent(ELyraHealthEventType Type, float OldValue, float NewValue, AActor* Instigator)
+{
+	if (HealthEventSubsystem)
+	{
+		FLyraHealthEvent Event;
+		Event.Type = Type;
+		Event.HealthComponent = this;
+		Event.Instigator = Instigator;
+		Event.OldValue = OldValue;
+		Event.NewValue = NewValue;
+		HealthEventSubsystem->PushEvent(Event);
+	}
 }
 
 void ULyraHealthComponent::ClearGameplayTags()
@@ -147,7 +169,16 @@ static AActor* GetInstigatorFromAttrChangeData(const FOnAttributeChangeData& Cha
 
 void ULyraHealthComponent::HandleHealthChanged(const FOnAttributeChangeData& ChangeData)
 {
-	OnHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
+	AActor* Instigator = GetInstigatorFromAttrChangeData(ChangeData);
+	PushHealthEvent(ELyraHealthEventType::HealthChanged, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+	if (bBroadcastAttributeChangeDelegates)
+	{
+		OnHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+	}
+	else
+	{
+		ensureMsgf(!OnHealthChanged.IsBound(), TEXT("%s: OnHealthChanged is bound but bBroadcastAttributeChangeDelegates is off, the binding will never fire. Read ULyraHealthEventSubsystem instead."), *GetPathNameSafe(this));
+	}
 
 #if WITH_SERVER_CODE
 	// Failsafe: some systems may override Health directly (e.g. SetNumericAttributeBase) which can bypass
@@ -176,11 +207,22 @@ void ULyraHealthComponent::HandleHealthChanged(const FOnAttributeChangeData& Cha
 
 void ULyraHealthComponent::HandleMaxHealthChanged(const FOnAttributeChangeData& ChangeData)
 {
-	OnMaxHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
+	AActor* Instigator = GetInstigatorFromAttrChangeData(ChangeData);
+	PushHealthEvent(ELyraHealthEventType::MaxHealthChanged, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+	if (bBroadcastAttributeChangeDelegates)
+	{
+		OnMaxHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+	}
+	else
+	{
+		ensureMsgf(!OnMaxHealthChanged.IsBound(), TEXT("%s: OnMaxHealthChanged is bound but bBroadcastAttributeChangeDelegates is off, the binding will never fire. Read ULyraHealthEventSubsystem instead."), *GetPathNameSafe(this));
+	}
 }
 
 void ULyraHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec& DamageEffectSpec, float DamageMagnitude)
 {
+	PushHealthEvent(ELyraHealthEventType::OutOfHealth, GetHealth(), GetHealth(), DamageInstigator);
+
 #if WITH_SERVER_CODE
 	if (AbilitySystemComponent)
 	{
@@ -283,6 +325,7 @@ void ULyraHealthComponent::StartDeath()
 	AActor* Owner = GetOwner();
 	check(Owner);
 
+	PushHealthEvent(ELyraHealthEventType::DeathStarted, GetHealth(), GetHealth(), nullptr);
 	OnDeathStarted.Broadcast(Owner);
 
 	Owner->ForceNetUpdate();
@@ -305,6 +348,7 @@ void ULyraHealthComponent::FinishDeath()
 	AActor* Owner = GetOwner();
 	check(Owner);
 
+	PushHealthEvent(ELyraHealthEventType::DeathFinished, GetHealth(), GetHealth(), nullptr);
 	OnDeathFinished.Broadcast(Owner);
 
 	Owner->ForceNetUpdate();
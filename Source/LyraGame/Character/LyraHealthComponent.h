@@ -3,12 +3,14 @@
 #pragma once
 
 #include "Components/GameFrameworkComponent.h"
+#include "Character/LyraHealthEventSubsystem.h"
 
 #include "LyraHealthComponent.generated.h"
 
 class ULyraHealthComponent;
 
 class ULyraAbilitySystemComponent;
+class ULyraHealthEventSubsystem;
 class ULyraHealthSet;
 class UObject;
 struct FFrame;
@@ -38,6 +40,8 @@ enum class ELyraDeathState : uint8
  * ULyraHealthComponent
  *
  *	An actor component used to handle anything related to health.
+ *	Every change is also pushed to the world's ULyraHealthEventSubsystem, which is the preferred way to observe
+ *	many actors at once.
  */
 UCLASS(Blueprintable, Meta=(BlueprintSpawnableComponent))
 class LYRAGAME_API ULyraHealthComponent : public UGameFrameworkComponent
@@ -89,6 +93,12 @@ public:
 
 public:
 
+	// If false, health and max health changes are only reported through ULyraHealthEventSubsystem and OnHealthChanged/OnMaxHealthChanged
+	// don't fire. Only turn it off for pawns whose health consumers all read the event stream (the block health component and the
+	// AI state observer do), anything still bound to those delegates stops hearing about changes. Death delegates always fire.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lyra|Health")
+	bool bBroadcastAttributeChangeDelegates = true;
+
 	// Delegate fired when the health value has changed.
 	UPROPERTY(BlueprintAssignable)
 	FLyraHealth_AttributeChanged OnHealthChanged;
@@ -115,6 +125,8 @@ protected:
 	virtual void HandleMaxHealthChanged(const FOnAttributeChangeData& ChangeData);
 	virtual void HandleOutOfHealth(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec& DamageEffectSpec, float DamageMagnitude);
 
+	void PushHealthEvent(ELyraHealthEventType Type, float OldValue, float NewValue, AActor* Instigator);
+
 	UFUNCTION()
 	virtual void OnRep_DeathState(ELyraDeathState OldDeathState);
 
@@ -128,6 +140,10 @@ protected:
 	UPROPERTY()
 	TObjectPtr<const ULyraHealthSet> HealthSet;
 
+	// Event stream of the world this component is in.
+	UPROPERTY(Transient)
+	TObjectPtr<ULyraHealthEventSubsystem> HealthEventSubsystem;
+
 	// Replicated state used to handle dying.
 	UPROPERTY(ReplicatedUsing = OnRep_DeathState)
 	ELyraDeathState DeathState;
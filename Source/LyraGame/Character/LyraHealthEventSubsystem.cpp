@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraHealthEventSubsystem.h"
+
+#include "Character/LyraHealthComponent.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraHealthEventSubsystem)
+
+bool ULyraHealthEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void ULyraHealthEventSubsystem::Deinitialize()
+{
+	PendingEvents.Reset();
+	ProcessingEvents.Reset();
+	ComponentEventsScratch.Reset();
+	HealthEventsDelegate.Clear();
+	OnHealthEventsBatch.Clear();
+	ComponentConsumers.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId ULyraHealthEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraHealthEventSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType ULyraHealthEventSubsystem::GetTickableTickType() const
+{
+	// Only tick on frames where something happened
+	return (Super::GetTickableTickType() == ETickableTickType::Never) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool ULyraHealthEventSubsystem::IsTickable() const
+{
+	return !PendingEvents.IsEmpty();
+}
+
+void ULyraHealthEventSubsystem::Tick(float DeltaTime)
+{
+	Swap(PendingEvents, ProcessingEvents);
+
+	DispatchToComponentConsumers();
+	HealthEventsDelegate.Broadcast(ProcessingEvents);
+	OnHealthEventsBatch.Broadcast(ProcessingEvents);
+
+	ProcessingEvents.Reset();
+}
+
+FDelegateHandle ULyraHealthEventSubsystem::AddComponentEventsConsumer(const ULyraHealthComponent* HealthComponent, FLyraHealthEventBatchDelegate::FDelegate&& Consumer)
+{
+	if (HealthComponent == nullptr)
+	{
+		return FDelegateHandle();
+	}
+
+	return ComponentConsumers.FindOrAdd(FObjectKey(HealthComponent)).Add(MoveTemp(Consumer));
+}
+
+void ULyraHealthEventSubsystem::RemoveComponentEventsConsumer(const ULyraHealthComponent* HealthComponent, FDelegateHandle Handle)
+{
+	const FObjectKey ComponentKey(HealthComponent);
+	if (FLyraHealthEventBatchDelegate* Consumers = ComponentConsumers.Find(ComponentKey))
+	{
+		Consumers->Remove(Handle);
+		if (!Consumers->IsBound())
+		{
+			ComponentConsumers.Remove(ComponentKey);
+		}
+	}
+}
+
+void ULyraHealthEventSubsystem::DispatchToComponentConsumers()
+{
+	if (ComponentConsumers.IsEmpty())
+	{
+		return;
+	}
+
+	// Keep only the events somebody listens to, grouped per component. The sort is stable so each component's events stay in order.
+	ComponentEventsScratch.Reset();
+	for (const FLyraHealthEvent& Event : ProcessingEvents)
+	{
+		if (ComponentConsumers.Contains(FObjectKey(Event.HealthComponent)))
+		{
+			ComponentEventsScratch.Add(Event);
+		}
+	}
+
+	ComponentEventsScratch.StableSort([](const FLyraHealthEvent& A, const FLyraHealthEvent& B)
+		{
+			return (UPTRINT)A.HealthComponent.Get() < (UPTRINT)B.HealthComponent.Get();
+		});
+
+	int32 RunStart = 0;
+	while (RunStart < ComponentEventsScratch.Num())
+	{
+		const ULyraHealthComponent* HealthComponent = ComponentEventsScratch[RunStart].HealthComponent;
+
+		int32 RunEnd = RunStart + 1;
+		while ((RunEnd < ComponentEventsScratch.Num()) && (ComponentEventsScratch[RunEnd].HealthComponent == HealthComponent))
+		{
+			++RunEnd;
+		}
+
+		// Looked up again for every component and copied, consumers may add or remove consumers while being called
+		if (const FLyraHealthEventBatchDelegate* Consumers = ComponentConsumers.Find(FObjectKey(HealthComponent)))
+		{
+			const FLyraHealthEventBatchDelegate ConsumersCopy = *Consumers;
+			ConsumersCopy.Broadcast(TConstArrayView<FLyraHealthEvent>(ComponentEventsScratch.GetData() + RunStart, RunEnd - RunStart));
+		}
+
+		RunStart = RunEnd;
+	}
+
+	ComponentEventsScratch.Reset();
+}
@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraHealthEventSubsystem.generated.h"
+
+class AActor;
+class ULyraHealthComponent;
+
+/** What happened to a health component */
+UENUM(BlueprintType)
+enum class ELyraHealthEventType : uint8
+{
+	HealthChanged,
+	MaxHealthChanged,
+	OutOfHealth,
+	DeathStarted,
+	DeathFinished
+};
+
+/** A single change pushed by a health component, OldValue/NewValue are only meaningful for the attribute changes */
+USTRUCT(BlueprintType)
+struct FLyraHealthEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|Health")
+	ELyraHealthEventType Type = ELyraHealthEventType::HealthChanged;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|Health")
+	TObjectPtr<ULyraHealthComponent> HealthComponent = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|Health")
+	TObjectPtr<AActor> Instigator = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|Health")
+	float OldValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|Health")
+	float NewValue = 0.0f;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FLyraHealthEventBatchDelegate, TConstArrayView<FLyraHealthEvent> /*Events*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraHealthEventBatchDynamicDelegate, const TArray<FLyraHealthEvent>&, Events);
+
+/**
+ * ULyraHealthEventSubsystem
+ *
+ *	World-level stream of health and death events. Health components push compact records as things happen,
+ *	and consumers (UI, AI observers, accolades, ...) receive everything that happened during the frame as one
+ *	batch at the end of it, instead of binding to every actor's health delegates.
+ *	Consumers that only care about one health component register for it, and get just that component's events.
+ */
+UCLASS()
+class LYRAGAME_API ULyraHealthEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	//~End of FTickableGameObject interface
+
+	void PushEvent(const FLyraHealthEvent& Event) { PendingEvents.Add(Event); }
+
+	// Native consumers, called once per frame with every event pushed since the last batch
+	FLyraHealthEventBatchDelegate& OnHealthEvents() { return HealthEventsDelegate; }
+
+	// Native consumers of a single health component, called once per frame with that component's events only (if it had any)
+	FDelegateHandle AddComponentEventsConsumer(const ULyraHealthComponent* HealthComponent, FLyraHealthEventBatchDelegate::FDelegate&& Consumer);
+	void RemoveComponentEventsConsumer(const ULyraHealthComponent* HealthComponent, FDelegateHandle Handle);
+
+	// Blueprint consumers, called right after the native ones
+	UPROPERTY(BlueprintAssignable, Category = "Lyra|Health")
+	FLyraHealthEventBatchDynamicDelegate OnHealthEventsBatch;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	void DispatchToComponentConsumers();
+
+	UPROPERTY(Transient)
+	TArray<FLyraHealthEvent> PendingEvents;
+
+	// Events being broadcast, anything pushed by a consumer goes to the next batch
+	UPROPERTY(Transient)
+	TArray<FLyraHealthEvent> ProcessingEvents;
+
+	// The events of ProcessingEvents that have a component consumer, grouped by component
+	UPROPERTY(Transient)
+	TArray<FLyraHealthEvent> ComponentEventsScratch;
+
+	FLyraHealthEventBatchDelegate HealthEventsDelegate;
+
+	TMap<FObjectKey, FLyraHealthEventBatchDelegate> ComponentConsumers;
+};
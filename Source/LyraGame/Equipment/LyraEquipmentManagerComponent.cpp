@@ -3,6 +3,7 @@
 #include "LyraEquipmentManagerComponent.h"
 
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "AbilitySystemGlobals.h"
 #include "Engine/ActorChannel.h"
 #include "LyraEquipmentDefinition.h"
@@ -45,6 +46,16 @@ void FLyraEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 		if (Entry.Instance != nullptr)
 		{
 			Entry.Instance->OnEquipped();
+
+			// Ability sets are only granted on the authority, clients learn what the equipment can do from the definition
+			ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get();
+			if (GCM && (Entry.EquipmentDefinition != nullptr))
+			{
+				for (const TObjectPtr<const ULyraAbilitySet>& AbilitySet : GetDefault<ULyraEquipmentDefinition>(Entry.EquipmentDefinition)->AbilitySetsToGrant)
+				{
+					GCM->PreloadCuesForAbilitySet(AbilitySet, Entry.Instance);
+				}
+			}
 		}
 	}
 }
@@ -149,6 +149,9 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 		}
 
 		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+
+		// Let each slot hear about all of this feature's widgets at once
+		FScopedUIExtensionBatch ExtensionBatch(ExtensionSubsystem);
 		for (const FLyraHUDElementEntry& Entry : Widgets)
 		{
 			ActorData.ExtensionHandles.Add(ExtensionSubsystem->RegisterExtensionAsWidgetForContext(Entry.SlotID, LocalPlayer, Entry.WidgetClass.Get(), -1));
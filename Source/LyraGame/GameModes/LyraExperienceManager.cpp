@@ -2,11 +2,65 @@
 
 #include "LyraExperienceManager.h"
 #include "GameModes/LyraExperienceManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "Engine/Engine.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "LyraExperienceActionSet.h"
+#include "LyraExperienceDefinition.h"
+#include "LyraLogChannels.h"
 #include "Subsystems/SubsystemCollection.h"
+#include "System/LyraAssetManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManager)
 
+namespace LyraExperiencePreload
+{
+	static bool bEnablePreloading = true;
+	static FAutoConsoleVariableRef CVarEnablePreloading(
+		TEXT("Lyra.Experience.Preload.Enable"),
+		bEnablePreloading,
+		TEXT("Allows experiences to be preloaded in the background before they are activated"),
+		ECVF_Default);
+
+	static int32 MaxConcurrentPreloads = 1;
+	static FAutoConsoleVariableRef CVarMaxConcurrentPreloads(
+		TEXT("Lyra.Experience.Preload.MaxConcurrent"),
+		MaxConcurrentPreloads,
+		TEXT("Maximum number of experiences kept preloaded at once, starting a new preload cancels the oldest"),
+		ECVF_Default);
+
+	static int32 MaxPreloadMemoryMB = 1024;
+	static FAutoConsoleVariableRef CVarMaxPreloadMemoryMB(
+		TEXT("Lyra.Experience.Preload.MaxMemoryMB"),
+		MaxPreloadMemoryMB,
+		TEXT("A finished preload bigger than this (on-disk package size) is released again. 0 disables the limit"),
+		ECVF_Default);
+
+	static int32 MinFreePhysicalMemoryMB = 1024;
+	static FAutoConsoleVariableRef CVarMinFreePhysicalMemoryMB(
+		TEXT("Lyra.Experience.Preload.MinFreePhysicalMB"),
+		MinFreePhysicalMemoryMB,
+		TEXT("Preloads are not started when less than this much physical memory is available"),
+		ECVF_Default);
+
+	static TArray<FName> GetBundlesToLoad()
+	{
+		// Same bundles ULyraExperienceManagerComponent::StartExperienceLoad asks for, we don't know our net mode yet
+		TArray<FName> BundlesToLoad;
+		BundlesToLoad.Add(FLyraBundles::Equipped);
+		if (GIsEditor || !IsRunningDedicatedServer())
+		{
+			BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+		}
+		if (GIsEditor || !IsRunningClientOnly())
+		{
+			BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+		}
+		return BundlesToLoad;
+	}
+}
+
 #if WITH_EDITOR
 
 void ULyraExperienceManager::OnPlayInEditorBegun()
@@ -52,3 +106,333 @@ bool ULyraExperienceManager::RequestToDeactivatePlugin(const FString PluginURL)
 }
 
 #endif
+
+ULyraExperienceManager* ULyraExperienceManager::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<ULyraExperienceManager>() : nullptr;
+}
+
+void ULyraExperienceManager::Deinitialize()
+{
+	CancelAllExperiencePreloads();
+
+	Super::Deinitialize();
+}
+
+bool ULyraExperienceManager::PreloadExperience(FPrimaryAssetId ExperienceId)
+{
+	if (!LyraExperiencePreload::bEnablePreloading || !ExperienceId.IsValid())
+	{
+		return false;
+	}
+
+	if (FindPreload(ExperienceId) != nullptr)
+	{
+		return true;
+	}
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+
+	// Already resident (most likely the running experience), nothing to warm up
+	if (AssetManager.GetPrimaryAssetObject(ExperienceId) != nullptr)
+	{
+		return true;
+	}
+
+	const uint64 FreePhysicalMB = FPlatformMemory::GetStats().AvailablePhysical / (1024 * 1024);
+	if (FreePhysicalMB < (uint64)FMath::Max(LyraExperiencePreload::MinFreePhysicalMemoryMB, 0))
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Not preloading %s, only %llu MB of physical memory available"), *ExperienceId.ToString(), FreePhysicalMB);
+		return false;
+	}
+
+	// Make room, oldest preload goes first
+	while (ActivePreloads.Num() > 0 && ActivePreloads.Num() >= FMath::Max(LyraExperiencePreload::MaxConcurrentPreloads, 1))
+	{
+		CancelExperiencePreload(ActivePreloads[0]->ExperienceId);
+	}
+
+	TSharedPtr<FExperiencePreload> Preload = MakeShared<FExperiencePreload>();
+	Preload->ExperienceId = ExperienceId;
+	Preload->StartTime = FPlatformTime::Seconds();
+	ActivePreloads.Add(Preload);
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preloading %s in the background"), *ExperienceId.ToString());
+
+	// Preloaded assets are only kept alive by our handles, not put into the asset manager's loaded state, so releasing
+	// them never unloads anything the running experience (or the component that consumes the preload) is holding on to.
+	// Background priority, this must not compete with loads the current game is waiting on
+	TSharedPtr<FStreamableHandle> Handle = AssetManager.PreloadPrimaryAssets({ ExperienceId }, LyraExperiencePreload::GetBundlesToLoad(), /*bLoadRecursive=*/ false,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadExperienceLoaded, ExperienceId), FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (Handle.IsValid())
+	{
+		Preload->Handles.Add(Handle);
+		AssetManager.TrackAsyncLoad(Handle, FString::Printf(TEXT("PreloadExperience(%s)"), *ExperienceId.ToString()));
+	}
+
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		OnPreloadExperienceLoaded(ExperienceId);
+	}
+
+	return true;
+}
+
+void ULyraExperienceManager::OnPreloadExperienceLoaded(FPrimaryAssetId ExperienceId)
+{
+	FExperiencePreload* Preload = FindPreload(ExperienceId);
+	if (Preload == nullptr || Preload->bDefinitionLoaded)
+	{
+		return;
+	}
+	Preload->bDefinitionLoaded = true;
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	UClass* AssetClass = Cast<UClass>(AssetManager.GetPrimaryAssetPath(ExperienceId).ResolveObject());
+	const ULyraExperienceDefinition* Experience = AssetClass ? GetDefault<ULyraExperienceDefinition>(AssetClass) : nullptr;
+	if (Experience == nullptr)
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Preload of %s failed to load the experience definition"), *ExperienceId.ToString());
+		CancelExperiencePreload(ExperienceId);
+		return;
+	}
+
+	// Action sets and their bundles
+	TArray<FPrimaryAssetId> ActionSetIds;
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			ActionSetIds.AddUnique(ActionSet->GetPrimaryAssetId());
+		}
+	}
+
+	// Game feature plugins get loaded (mounted, registered and their content loaded) but not activated,
+	// activation still happens through the experience manager component after travel
+	TArray<FString> PluginURLs;
+	auto CollectGameFeaturePluginURLs = [&PluginURLs](const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				PluginURLs.AddUnique(PluginURL);
+			}
+		}
+	};
+
+	CollectGameFeaturePluginURLs(Experience->GameFeaturesToEnable);
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectGameFeaturePluginURLs(ActionSet->GameFeaturesToEnable);
+		}
+	}
+
+	for (const FString& PluginURL : PluginURLs)
+	{
+		if (!UGameFeaturesSubsystem::Get().IsGameFeaturePluginLoaded(PluginURL))
+		{
+			Preload->LoadedPluginURLs.Add(PluginURL);
+			++Preload->NumPluginsLoading;
+		}
+	}
+
+	TSharedPtr<FStreamableHandle> ActionSetHandle;
+	if (ActionSetIds.Num() > 0)
+	{
+		ActionSetHandle = AssetManager.PreloadPrimaryAssets(ActionSetIds, LyraExperiencePreload::GetBundlesToLoad(), /*bLoadRecursive=*/ false,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadActionSetsLoaded, ExperienceId), FStreamableManager::DefaultAsyncLoadPriority);
+		if (ActionSetHandle.IsValid())
+		{
+			Preload->Handles.Add(ActionSetHandle);
+			AssetManager.TrackAsyncLoad(ActionSetHandle, FString::Printf(TEXT("PreloadExperience(%s) action sets"), *ExperienceId.ToString()));
+		}
+	}
+
+	// Copy the list, plugin loads can complete synchronously and finish (or cancel) the preload
+	const TArray<FString> PluginsToLoad = Preload->LoadedPluginURLs;
+	const bool bActionSetsPending = ActionSetHandle.IsValid() && !ActionSetHandle->HasLoadCompleted();
+
+	for (const FString& PluginURL : PluginsToLoad)
+	{
+		UGameFeaturesSubsystem::Get().LoadGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnPreloadPluginLoaded, ExperienceId));
+	}
+
+	if (!bActionSetsPending)
+	{
+		OnPreloadActionSetsLoaded(ExperienceId);
+	}
+}
+
+void ULyraExperienceManager::OnPreloadActionSetsLoaded(FPrimaryAssetId ExperienceId)
+{
+	if (FExperiencePreload* Preload = FindPreload(ExperienceId))
+	{
+		Preload->bAssetsLoaded = true;
+		TryFinishPreload(ExperienceId);
+	}
+}
+
+void ULyraExperienceManager::OnPreloadPluginLoaded(const UE::GameFeatures::FResult& Result, FPrimaryAssetId ExperienceId)
+{
+	if (FExperiencePreload* Preload = FindPreload(ExperienceId))
+	{
+		--Preload->NumPluginsLoading;
+		TryFinishPreload(ExperienceId);
+	}
+}
+
+void ULyraExperienceManager::TryFinishPreload(FPrimaryAssetId ExperienceId)
+{
+	FExperiencePreload* Preload = FindPreload(ExperienceId);
+	if (Preload == nullptr || !Preload->bAssetsLoaded || Preload->NumPluginsLoading > 0)
+	{
+		return;
+	}
+
+	// Estimate what the preload costs from the on-disk size of everything it pulled in
+	TSet<FName> PackageNames;
+	for (const TSharedPtr<FStreamableHandle>& Handle : Preload->Handles)
+	{
+		TArray<UObject*> LoadedAssets;
+		Handle->GetLoadedAssets(LoadedAssets);
+		for (const UObject* LoadedAsset : LoadedAssets)
+		{
+			if (LoadedAsset)
+			{
+				PackageNames.Add(LoadedAsset->GetPackage()->GetFName());
+			}
+		}
+	}
+
+	int64 EstimatedBytes = 0;
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		for (const FName PackageName : PackageNames)
+		{
+			if (const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName))
+			{
+				EstimatedBytes += FMath::Max<int64>(PackageData->DiskSize, 0);
+			}
+		}
+	}
+
+	const double EstimatedMB = (double)EstimatedBytes / (1024.0 * 1024.0);
+	if (LyraExperiencePreload::MaxPreloadMemoryMB > 0 && EstimatedMB > LyraExperiencePreload::MaxPreloadMemoryMB)
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Preload of %s is %.1f MB, over the %d MB budget, releasing it"),
+			*ExperienceId.ToString(), EstimatedMB, LyraExperiencePreload::MaxPreloadMemoryMB);
+		CancelExperiencePreload(ExperienceId);
+		return;
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preloaded %s in %.2f seconds (%d packages, ~%.1f MB, %d plugins loaded)"),
+		*ExperienceId.ToString(), FPlatformTime::Seconds() - Preload->StartTime, PackageNames.Num(), EstimatedMB, Preload->LoadedPluginURLs.Num());
+}
+
+bool ULyraExperienceManager::IsExperiencePreloaded(FPrimaryAssetId ExperienceId) const
+{
+	for (const TSharedPtr<FExperiencePreload>& Preload : ActivePreloads)
+	{
+		if (Preload->ExperienceId == ExperienceId)
+		{
+			return Preload->bAssetsLoaded && (Preload->NumPluginsLoading == 0);
+		}
+	}
+
+	return false;
+}
+
+bool ULyraExperienceManager::ConsumeExperiencePreload(FPrimaryAssetId ExperienceId)
+{
+	const int32 PreloadIndex = ActivePreloads.IndexOfByPredicate([&ExperienceId](const TSharedPtr<FExperiencePreload>& Preload) { return Preload->ExperienceId == ExperienceId; });
+	if (PreloadIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TSharedPtr<FExperiencePreload> Preload = ActivePreloads[PreloadIndex];
+	ActivePreloads.RemoveAt(PreloadIndex);
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Using preload of %s (%s)"), *ExperienceId.ToString(),
+		(Preload->bAssetsLoaded && Preload->NumPluginsLoading == 0) ? TEXT("complete") : TEXT("still loading"));
+
+	// The component has already requested the same assets, so dropping our handles keeps them resident. The plugins stay loaded.
+	ReleasePreload(*Preload, /*bUnloadPlugins=*/ false);
+	return true;
+}
+
+void ULyraExperienceManager::CancelExperiencePreload(FPrimaryAssetId ExperienceId)
+{
+	const int32 PreloadIndex = ActivePreloads.IndexOfByPredicate([&ExperienceId](const TSharedPtr<FExperiencePreload>& Preload) { return Preload->ExperienceId == ExperienceId; });
+	if (PreloadIndex != INDEX_NONE)
+	{
+		TSharedPtr<FExperiencePreload> Preload = ActivePreloads[PreloadIndex];
+		ActivePreloads.RemoveAt(PreloadIndex);
+
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Cancelled preload of %s"), *ExperienceId.ToString());
+		ReleasePreload(*Preload, /*bUnloadPlugins=*/ true);
+	}
+}
+
+void ULyraExperienceManager::CancelAllExperiencePreloads()
+{
+	while (ActivePreloads.Num() > 0)
+	{
+		CancelExperiencePreload(ActivePreloads.Last()->ExperienceId);
+	}
+}
+
+ULyraExperienceManager::FExperiencePreload* ULyraExperienceManager::FindPreload(const FPrimaryAssetId& ExperienceId)
+{
+	for (const TSharedPtr<FExperiencePreload>& Preload : ActivePreloads)
+	{
+		if (Preload->ExperienceId == ExperienceId)
+		{
+			return Preload.Get();
+		}
+	}
+
+	return nullptr;
+}
+
+void ULyraExperienceManager::ReleasePreload(FExperiencePreload& Preload, bool bUnloadPlugins)
+{
+	// Only drop our own references, anything else holding on to these assets keeps them loaded
+	for (const TSharedPtr<FStreamableHandle>& Handle : Preload.Handles)
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		if (Handle->IsLoadingInProgress())
+		{
+			Handle->CancelHandle();
+		}
+		else
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+	Preload.Handles.Reset();
+
+	if (bUnloadPlugins)
+	{
+		// Only unload plugins we loaded and nobody has activated since
+		if (UGameFeaturesSubsystem* GameFeatures = GEngine ? GEngine->GetEngineSubsystem<UGameFeaturesSubsystem>() : nullptr)
+		{
+			for (const FString& PluginURL : Preload.LoadedPluginURLs)
+			{
+				if (!GameFeatures->IsGameFeaturePluginActive(PluginURL))
+				{
+					GameFeatures->UnloadGameFeaturePlugin(PluginURL);
+				}
+			}
+		}
+	}
+}
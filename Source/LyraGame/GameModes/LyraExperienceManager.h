@@ -3,10 +3,17 @@
 #pragma once
 
 #include "Subsystems/EngineSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
 #include "LyraExperienceManager.generated.h"
 
+namespace UE::GameFeatures { struct FResult; }
+struct FStreamableHandle;
+
 /**
  * Manager for experiences - primarily for arbitration between multiple PIE sessions
+ *
+ * Also owns background preloads of experiences we expect to switch to next (driven by the front end
+ * experience list and session hosting), so that activation after travel finds everything resident.
  */
 UCLASS(MinimalAPI)
 class ULyraExperienceManager : public UEngineSubsystem
@@ -24,6 +31,58 @@ public:
 	static bool RequestToDeactivatePlugin(const FString PluginURL) { return true; }
 #endif
 
+	LYRAGAME_API static ULyraExperienceManager* Get();
+
+	// Starts loading an experience's assets (and its action sets) and loading, but not activating, its game feature plugins.
+	// Returns false if preloading is disabled or the memory budget does not allow it.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Experience")
+	LYRAGAME_API bool PreloadExperience(FPrimaryAssetId ExperienceId);
+
+	// Stops a preload and releases what it loaded, unless an experience manager component has already picked it up
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Experience")
+	LYRAGAME_API void CancelExperiencePreload(FPrimaryAssetId ExperienceId);
+
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Experience")
+	LYRAGAME_API void CancelAllExperiencePreloads();
+
+	// Returns true once all assets and plugins for a preloaded experience are loaded
+	UFUNCTION(BlueprintPure, Category = "Lyra|Experience")
+	LYRAGAME_API bool IsExperiencePreloaded(FPrimaryAssetId ExperienceId) const;
+
+	// Hands a preload over to an experience that is starting to load, the loaded assets and plugins stay resident.
+	// Returns true if there was a preload for this experience.
+	LYRAGAME_API bool ConsumeExperiencePreload(FPrimaryAssetId ExperienceId);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+private:
+	struct FExperiencePreload
+	{
+		FPrimaryAssetId ExperienceId;
+
+		// Preload handles for the experience and its action sets, these are the only references the preload holds
+		TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+		// Plugins this preload loaded, only these are unloaded again on cancel
+		TArray<FString> LoadedPluginURLs;
+		int32 NumPluginsLoading = 0;
+
+		bool bDefinitionLoaded = false;
+		bool bAssetsLoaded = false;
+		double StartTime = 0.0;
+	};
+
+	FExperiencePreload* FindPreload(const FPrimaryAssetId& ExperienceId);
+	void OnPreloadExperienceLoaded(FPrimaryAssetId ExperienceId);
+	void OnPreloadActionSetsLoaded(FPrimaryAssetId ExperienceId);
+	void OnPreloadPluginLoaded(const UE::GameFeatures::FResult& Result, FPrimaryAssetId ExperienceId);
+	void TryFinishPreload(FPrimaryAssetId ExperienceId);
+	void ReleasePreload(FExperiencePreload& Preload, bool bUnloadPlugins);
+
+	TArray<TSharedPtr<FExperiencePreload>> ActivePreloads;
+
 private:
 	// The map of requests to active count for a given game feature plugin
 	// (to allow first in, last out activation management during PIE)
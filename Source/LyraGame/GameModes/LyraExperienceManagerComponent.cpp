@@ -186,6 +186,15 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 		Handle = BundleLoadHandle.IsValid() ? BundleLoadHandle : RawLoadHandle;
 	}
 
+	AssetManager.TrackAsyncLoad(Handle, TEXT("StartExperienceLoad()"));
+
+	// If the front end or session already warmed this experience up, the loads above found everything resident.
+	// Our requests now hold those assets, so the preload can let go of its own handles.
+	if (ULyraExperienceManager* ExperienceManager = ULyraExperienceManager::Get())
+	{
+		ExperienceManager->ConsumeExperiencePreload(CurrentExperience->GetPrimaryAssetId());
+	}
+
 	FStreamableDelegate OnAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceLoadComplete);
 	if (!Handle.IsValid() || Handle->HasLoadCompleted())
 	{
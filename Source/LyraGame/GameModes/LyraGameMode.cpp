@@ -254,6 +254,9 @@ void ALyraGameMode::HostDedicatedServerMatch(ECommonSessionOnlineMode OnlineMode
 
 			// TODO override other parameters?
 
+			// Get the experience loading while the session is created and the map travels
+			FoundExperience->PreloadExperience();
+
 			UCommonSessionSubsystem* SessionSubsystem = GameInstance->GetSubsystem<UCommonSessionSubsystem>();
 			SessionSubsystem->HostSession(nullptr, HostRequest);
 			
@@ -6,6 +6,7 @@
 #include "CommonUISettings.h"
 #include "Containers/UnrealString.h"
 #include "ICommonUIModule.h"
+#include "LyraExperienceManager.h"
 #include "NativeGameplayTags.h"
 #include "UObject/NameTypes.h"
 
@@ -40,3 +41,18 @@ UCommonSession_HostSessionRequest* ULyraUserFacingExperienceDefinition::CreateHo
 	return Result;
 }
 
+void ULyraUserFacingExperienceDefinition::PreloadExperience() const
+{
+	if (ULyraExperienceManager* ExperienceManager = ULyraExperienceManager::Get())
+	{
+		ExperienceManager->PreloadExperience(ExperienceID);
+	}
+}
+
+void ULyraUserFacingExperienceDefinition::CancelPreloadExperience() const
+{
+	if (ULyraExperienceManager* ExperienceManager = ULyraExperienceManager::Get())
+	{
+		ExperienceManager->CancelExperiencePreload(ExperienceID);
+	}
+}
@@ -15,7 +15,7 @@ struct FFrame;
 
 /** Description of settings used to display experiences in the UI and start a new session */
 UCLASS(BlueprintType)
-class ULyraUserFacingExperienceDefinition : public UPrimaryDataAsset
+class LYRAGAME_API ULyraUserFacingExperienceDefinition : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
@@ -72,4 +72,12 @@ public:
 	/** Create a request object that is used to actually start a session with these settings */
 	UFUNCTION(BlueprintCallable, BlueprintPure=false)
 	UCommonSession_HostSessionRequest* CreateHostingRequest() const;
+
+	/** Starts loading this experience in the background, e.g. when it gets selected in the front end or right before hosting it */
+	UFUNCTION(BlueprintCallable)
+	void PreloadExperience() const;
+
+	/** Cancels a preload started by PreloadExperience, e.g. when the selection moves on */
+	UFUNCTION(BlueprintCallable)
+	void CancelPreloadExperience() const;
 };
@@ -36,4 +36,17 @@ struct FLyraVerbMessage
 
 	// Returns a debug string representation of this message
 	LYRAGAME_API FString ToString() const;
+
+	// Compact network serialization: tags go through their net indices, empty containers cost a single bit
+	// and magnitudes are sent as packed integers when they are whole numbers (as they are for most verbs)
+	LYRAGAME_API bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLyraVerbMessage> : public TStructOpsTypeTraitsBase2<FLyraVerbMessage>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
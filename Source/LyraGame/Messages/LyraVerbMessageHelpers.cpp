@@ -20,6 +20,76 @@ FString FLyraVerbMessage::ToString() const
 	return HumanReadableMessage;
 }
 
+bool FLyraVerbMessage::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	bool bVerbSuccess = true;
+	Verb.NetSerialize(Ar, Map, bVerbSuccess);
+	bOutSuccess &= bVerbSuccess;
+
+	auto SerializeObject = [&](TObjectPtr<UObject>& Object)
+	{
+		UObject* RawObject = Object;
+		bOutSuccess &= Map->SerializeObject(Ar, UObject::StaticClass(), RawObject);
+		if (Ar.IsLoading())
+		{
+			Object = RawObject;
+		}
+	};
+
+	SerializeObject(Instigator);
+	SerializeObject(Target);
+
+	// Tag containers already send a single bit when they are empty
+	auto SerializeTags = [&](FGameplayTagContainer& Tags)
+	{
+		bool bTagsSuccess = true;
+		Tags.NetSerialize(Ar, Map, bTagsSuccess);
+		bOutSuccess &= bTagsSuccess;
+	};
+
+	SerializeTags(InstigatorTags);
+	SerializeTags(TargetTags);
+	SerializeTags(ContextTags);
+
+	// Magnitudes are usually 1 (eliminations, assists) or whole numbers (damage, scores), so only fall back to a float when needed
+	const bool bIsWholeNumber = (FMath::Frac(Magnitude) == 0.0) && (FMath::Abs(Magnitude) <= (double)MAX_int32);
+	uint8 bIsDefaultMagnitude = (Magnitude == 1.0);
+	uint8 bIsIntegerMagnitude = !bIsDefaultMagnitude && bIsWholeNumber;
+	Ar.SerializeBits(&bIsDefaultMagnitude, 1);
+	if (bIsDefaultMagnitude)
+	{
+		Magnitude = 1.0;
+	}
+	else
+	{
+		Ar.SerializeBits(&bIsIntegerMagnitude, 1);
+		if (bIsIntegerMagnitude)
+		{
+			uint8 bIsNegative = (Magnitude < 0.0);
+			uint32 AbsMagnitude = (uint32)FMath::Abs(Magnitude);
+			Ar.SerializeBits(&bIsNegative, 1);
+			Ar.SerializeIntPacked(AbsMagnitude);
+			if (Ar.IsLoading())
+			{
+				Magnitude = bIsNegative ? -(double)AbsMagnitude : (double)AbsMagnitude;
+			}
+		}
+		else
+		{
+			float QuantizedMagnitude = (float)Magnitude;
+			Ar << QuantizedMagnitude;
+			if (Ar.IsLoading())
+			{
+				Magnitude = QuantizedMagnitude;
+			}
+		}
+	}
+
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////
 // 
 
@@ -57,6 +57,13 @@ public:
 	// Removes a specified number of stacks from the tag (does nothing if StackCount is below 1)
 	void RemoveStack(FGameplayTag Tag, int32 StackCount);
 
+	// Starts a batch of stack changes; items touched until the matching EndBatch are only marked dirty once
+	// (prefer FScopedGameplayTagStackBatch over calling this directly)
+	void BeginBatch();
+
+	// Ends a batch of stack changes, marking every touched stack dirty for replication in one go
+	void EndBatch();
+
 	// Returns the stack count of the specified tag (or 0 if the tag is not present)
 	int32 GetStackCount(FGameplayTag Tag) const
 	{
@@ -80,6 +87,18 @@ public:
 		return FFastArraySerializer::FastArrayDeltaSerialize<FGameplayTagStack, FGameplayTagStackContainer>(Stacks, DeltaParms, *this);
 	}
 
+private:
+	// Returns the index of the stack for the tag in Stacks, or INDEX_NONE
+	int32 FindStackIndex(FGameplayTag Tag);
+
+	// Marks a stack as changed, deferring the dirty mark if a batch is open
+	void MarkStackDirty(FGameplayTagStack& Stack);
+
+	// Removes the stack at the specified index, keeping TagToIndexMap in sync
+	void RemoveStackAt(int32 Index);
+
+	void RebuildTagToIndexMap();
+
 private:
 	// Replicated list of gameplay tag stacks
 	UPROPERTY()
@@ -87,6 +106,48 @@ private:
 	
 	// Accelerated list of tag stacks for queries
 	TMap<FGameplayTag, int32> TagToCountMap;
+
+	// Index of each tag's entry in Stacks, so mutation doesn't need to scan the array
+	TMap<FGameplayTag, int32> TagToIndexMap;
+
+	// Tags modified while a batch was open, marked dirty when the batch ends
+	TSet<FGameplayTag> PendingDirtyTags;
+
+	// Number of open batches (see BeginBatch / EndBatch)
+	int32 BatchDepth = 0;
+
+	// Set when a stack was removed while a batch was open
+	bool bPendingArrayDirty = false;
+
+	// Set when replication reshuffled Stacks and TagToIndexMap needs to be rebuilt before the next mutation
+	bool bTagToIndexMapStale = false;
+};
+
+/**
+ * Groups multiple AddStack/RemoveStack calls on a container so they only produce a single replication dirty mark
+ * per touched stack, e.g.:
+ *
+ *	FScopedGameplayTagStackBatch Batch(StatTags);
+ *	StatTags.AddStack(...);
+ *	StatTags.RemoveStack(...);
+ */
+struct FScopedGameplayTagStackBatch
+{
+	explicit FScopedGameplayTagStackBatch(FGameplayTagStackContainer& InContainer)
+		: Container(InContainer)
+	{
+		Container.BeginBatch();
+	}
+
+	~FScopedGameplayTagStackBatch()
+	{
+		Container.EndBatch();
+	}
+
+	UE_NONCOPYABLE(FScopedGameplayTagStackBatch);
+
+private:
+	FGameplayTagStackContainer& Container;
 };
 
 template<>
@@ -0,0 +1,419 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraAssetLoadTracker.h"
+
+#include "Algo/Count.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "HAL/PlatformStackWalk.h"
+#include "LoadingScreenManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/OutputDevice.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAssetLoadTracker)
+
+namespace LyraAssetLoadTracking
+{
+	static int32 MaxRecords = 1024;
+	static FAutoConsoleVariableRef CVarMaxRecords(
+		TEXT("Lyra.AssetLoads.MaxRecords"),
+		MaxRecords,
+		TEXT("Number of recent asset loads kept for Lyra.AssetLoads.Dump"),
+		ECVF_Default);
+
+	static bool bWarnOnHitchRisk = true;
+	static FAutoConsoleVariableRef CVarWarnOnHitchRisk(
+		TEXT("Lyra.AssetLoads.WarnOnHitchRisk"),
+		bWarnOnHitchRisk,
+		TEXT("Log a warning for every synchronous asset load during gameplay"),
+		ECVF_Default);
+
+	static constexpr int32 MaxCallStackDepth = 12;
+	static constexpr int32 CallStackFramesToSkip = 3;
+}
+
+FLyraAssetLoadTracker::FLyraAssetLoadTracker()
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLyraAssetLoadTracker::Tick));
+}
+
+FLyraAssetLoadTracker::~FLyraAssetLoadTracker()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+}
+
+void FLyraAssetLoadTracker::SetBudgetCategories(const TArray<FLyraAssetBudgetCategory>& InCategories)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Categories = InCategories;
+	KeptAssetsByCategory.Reset();
+	KeptAssetsByCategory.SetNum(Categories.Num());
+}
+
+void FLyraAssetLoadTracker::RecordSyncLoad(const FSoftObjectPath& AssetPath, double StartTime, double Duration, const UObject* LoadedAsset)
+{
+	FLoadRecord Record;
+	Record.AssetPath = AssetPath;
+	Record.StartTime = StartTime;
+	Record.Duration = Duration;
+	Record.EstimatedBytes = LoadedAsset ? EstimatePackageSize(LoadedAsset->GetPackage()->GetFName()) : 0;
+	Record.bSynchronous = true;
+	Record.bHitchRisk = IsInGameThread() && IsDuringGameplay();
+#if LYRA_ASSET_LOAD_CALLSTACKS
+	CaptureCallStack(Record.CallStack);
+#endif
+
+	if (Record.bHitchRisk && LyraAssetLoadTracking::bWarnOnHitchRisk)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Synchronous load of [%s] during gameplay took %.2f ms, this is a hitch risk (see Lyra.AssetLoads.Dump for the call site)"),
+			*AssetPath.ToString(), Duration * 1000.0);
+	}
+
+	AddRecord(MoveTemp(Record));
+}
+
+void FLyraAssetLoadTracker::TrackAsyncLoad(const TSharedPtr<FStreamableHandle>& Handle, const FString& DebugName)
+{
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		return;
+	}
+
+	FPendingAsyncLoad PendingLoad;
+	PendingLoad.Handle = Handle;
+	PendingLoad.DebugName = DebugName;
+	PendingLoad.StartTime = FPlatformTime::Seconds();
+#if LYRA_ASSET_LOAD_CALLSTACKS
+	CaptureCallStack(PendingLoad.CallStack);
+#endif
+
+	FScopeLock ScopeLock(&Lock);
+	PendingAsyncLoads.Add(MoveTemp(PendingLoad));
+}
+
+bool FLyraAssetLoadTracker::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraAssetLoadTracker_Tick);
+
+	TArray<FPendingAsyncLoad> CompletedLoads;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (int32 PendingIndex = PendingAsyncLoads.Num() - 1; PendingIndex >= 0; --PendingIndex)
+		{
+			TSharedPtr<FStreamableHandle> Handle = PendingAsyncLoads[PendingIndex].Handle.Pin();
+			if (!Handle.IsValid() || Handle->WasCanceled())
+			{
+				PendingAsyncLoads.RemoveAtSwap(PendingIndex);
+			}
+			else if (Handle->HasLoadCompleted())
+			{
+				CompletedLoads.Add(MoveTemp(PendingAsyncLoads[PendingIndex]));
+				PendingAsyncLoads.RemoveAtSwap(PendingIndex);
+			}
+		}
+	}
+
+	// Completion is noticed on the next tick, so async durations are accurate to a frame
+	const double Now = FPlatformTime::Seconds();
+	for (FPendingAsyncLoad& CompletedLoad : CompletedLoads)
+	{
+		TSharedPtr<FStreamableHandle> Handle = CompletedLoad.Handle.Pin();
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		TArray<UObject*> LoadedAssets;
+		Handle->GetLoadedAssets(LoadedAssets);
+		for (const UObject* LoadedAsset : LoadedAssets)
+		{
+			if (LoadedAsset == nullptr)
+			{
+				continue;
+			}
+
+			FLoadRecord Record;
+			Record.AssetPath = FSoftObjectPath(LoadedAsset);
+			Record.RequestName = CompletedLoad.DebugName;
+			Record.StartTime = CompletedLoad.StartTime;
+			Record.Duration = Now - CompletedLoad.StartTime;
+			Record.EstimatedBytes = EstimatePackageSize(LoadedAsset->GetPackage()->GetFName());
+#if LYRA_ASSET_LOAD_CALLSTACKS
+			Record.CallStack = CompletedLoad.CallStack;
+#endif
+			AddRecord(MoveTemp(Record));
+		}
+	}
+
+	return true;
+}
+
+void FLyraAssetLoadTracker::AddRecord(FLoadRecord&& Record)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Record.CategoryIndex = FindCategory(Record.AssetPath);
+
+	if (Record.bSynchronous)
+	{
+		++TotalSyncLoads;
+		TotalSyncLoadSeconds += Record.Duration;
+		TotalHitchRisks += Record.bHitchRisk ? 1 : 0;
+	}
+	else
+	{
+		++TotalAsyncLoads;
+	}
+
+	const int32 MaxRecords = FMath::Max(LyraAssetLoadTracking::MaxRecords, 1);
+	if (Records.Num() > MaxRecords)
+	{
+		// The limit was lowered, keep the newest records (oldest first so the ring starts over at slot 0)
+		TArray<FLoadRecord> NewestRecords;
+		NewestRecords.Reserve(MaxRecords);
+		for (int32 Age = MaxRecords; Age > 0; --Age)
+		{
+			NewestRecords.Add(MoveTemp(Records[(NextRecordIndex - Age + Records.Num()) % Records.Num()]));
+		}
+		Records = MoveTemp(NewestRecords);
+		NextRecordIndex = 0;
+	}
+
+	if (Records.Num() < MaxRecords)
+	{
+		// Still growing (or the limit was raised), the new record goes right before the oldest one
+		Records.Insert(MoveTemp(Record), NextRecordIndex);
+	}
+	else
+	{
+		// Full, overwrite the oldest record
+		Records[NextRecordIndex] = MoveTemp(Record);
+	}
+	NextRecordIndex = (NextRecordIndex + 1) % MaxRecords;
+}
+
+bool FLyraAssetLoadTracker::NotifyKeptInMemory(const UObject* Asset, bool bPinned)
+{
+	const FSoftObjectPath AssetPath(Asset);
+
+	FScopeLock ScopeLock(&Lock);
+
+	const int32 CategoryIndex = FindCategory(AssetPath);
+	if (CategoryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const bool bHasBudget = Categories[CategoryIndex].BudgetMB > 0;
+	if (!bPinned && !bHasBudget)
+	{
+		return false;
+	}
+
+	TArray<FKeptAsset>& KeptAssets = KeptAssetsByCategory[CategoryIndex];
+	if (FKeptAsset* ExistingAsset = KeptAssets.FindByPredicate([Asset](const FKeptAsset& KeptAsset) { return KeptAsset.Asset.Get() == Asset; }))
+	{
+		// Someone asked to keep a cached asset in memory, it can't be evicted anymore
+		ExistingAsset->bPinned |= bPinned;
+		return bHasBudget;
+	}
+
+	FKeptAsset& KeptAsset = KeptAssets.AddDefaulted_GetRef();
+	KeptAsset.Asset = Asset;
+	KeptAsset.EstimatedBytes = EstimatePackageSize(Asset->GetPackage()->GetFName());
+	KeptAsset.KeptTime = FPlatformTime::Seconds();
+	KeptAsset.bPinned = bPinned;
+	return bHasBudget;
+}
+
+void FLyraAssetLoadTracker::GatherEvictions(TArray<const UObject*>& OutAssetsToEvict)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (int32 CategoryIndex = 0; CategoryIndex < Categories.Num(); ++CategoryIndex)
+	{
+		TArray<FKeptAsset>& KeptAssets = KeptAssetsByCategory[CategoryIndex];
+		KeptAssets.RemoveAll([](const FKeptAsset& KeptAsset) { return !KeptAsset.Asset.IsValid(); });
+
+		const int64 BudgetBytes = (int64)Categories[CategoryIndex].BudgetMB * 1024 * 1024;
+		if (BudgetBytes <= 0)
+		{
+			continue;
+		}
+
+		int64 UsageBytes = GetCategoryUsage(CategoryIndex);
+		if (UsageBytes <= BudgetBytes)
+		{
+			continue;
+		}
+
+		// Oldest cached assets first, pinned ones still count against the budget but are never evicted.
+		// Anything still referenced elsewhere survives the next GC anyway.
+		KeptAssets.Sort([](const FKeptAsset& A, const FKeptAsset& B) { return A.KeptTime < B.KeptTime; });
+
+		int32 NumEvicted = 0;
+		for (int32 KeptIndex = 0; KeptIndex < KeptAssets.Num() && UsageBytes > BudgetBytes; )
+		{
+			if (KeptAssets[KeptIndex].bPinned)
+			{
+				++KeptIndex;
+				continue;
+			}
+
+			OutAssetsToEvict.Add(KeptAssets[KeptIndex].Asset.Get());
+			UsageBytes -= KeptAssets[KeptIndex].EstimatedBytes;
+			KeptAssets.RemoveAt(KeptIndex);
+			++NumEvicted;
+		}
+
+		UE_LOG(LogLyra, Log, TEXT("Asset budget category %s is over its %d MB budget, releasing %d cached assets%s"),
+			*Categories[CategoryIndex].Name.ToString(), Categories[CategoryIndex].BudgetMB, NumEvicted,
+			(UsageBytes > BudgetBytes) ? TEXT(" (assets kept in memory on request are still over budget)") : TEXT(""));
+	}
+}
+
+void FLyraAssetLoadTracker::Dump(FOutputDevice& Ar) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Ar.Logf(TEXT("========== Asset Load Tracking =========="));
+	Ar.Logf(TEXT("%d sync loads (%.2f s total, %d during gameplay), %d async assets loaded"), TotalSyncLoads, TotalSyncLoadSeconds, TotalHitchRisks, TotalAsyncLoads);
+
+	Ar.Logf(TEXT("--- Budgets"));
+	for (int32 CategoryIndex = 0; CategoryIndex < Categories.Num(); ++CategoryIndex)
+	{
+		const TArray<FKeptAsset>& KeptAssets = KeptAssetsByCategory[CategoryIndex];
+		const int32 NumPinned = Algo::CountIf(KeptAssets, [](const FKeptAsset& KeptAsset) { return KeptAsset.bPinned; });
+		Ar.Logf(TEXT("  %-24s %8.1f MB kept / %d MB budget (%d kept in memory, %d cached)"), *Categories[CategoryIndex].Name.ToString(),
+			(double)GetCategoryUsage(CategoryIndex) / (1024.0 * 1024.0), Categories[CategoryIndex].BudgetMB, NumPinned, KeptAssets.Num() - NumPinned);
+	}
+
+	TArray<const FLoadRecord*> SortedRecords;
+	for (const FLoadRecord& Record : Records)
+	{
+		SortedRecords.Add(&Record);
+	}
+	SortedRecords.Sort([](const FLoadRecord& A, const FLoadRecord& B) { return A.Duration > B.Duration; });
+
+	Ar.Logf(TEXT("--- Slowest recent loads"));
+	for (int32 Index = 0; Index < FMath::Min(SortedRecords.Num(), 20); ++Index)
+	{
+		const FLoadRecord& Record = *SortedRecords[Index];
+		Ar.Logf(TEXT("  %8.2f ms %s %8.1f KB %-16s %s %s"), Record.Duration * 1000.0, Record.bSynchronous ? TEXT("sync ") : TEXT("async"),
+			(double)Record.EstimatedBytes / 1024.0, (Record.CategoryIndex != INDEX_NONE) ? *Categories[Record.CategoryIndex].Name.ToString() : TEXT("-"),
+			*Record.AssetPath.ToString(), *Record.RequestName);
+	}
+
+	Ar.Logf(TEXT("--- Hitch risks (sync loads during gameplay)"));
+	for (const FLoadRecord* Record : SortedRecords)
+	{
+		if (!Record->bHitchRisk)
+		{
+			continue;
+		}
+
+		Ar.Logf(TEXT("  %8.2f ms %s"), Record->Duration * 1000.0, *Record->AssetPath.ToString());
+#if LYRA_ASSET_LOAD_CALLSTACKS
+		for (const uint64 ProgramCounter : Record->CallStack)
+		{
+			ANSICHAR HumanReadable[1024];
+			HumanReadable[0] = '\0';
+			FPlatformStackWalk::ProgramCounterToHumanReadableString(0, ProgramCounter, HumanReadable, UE_ARRAY_COUNT(HumanReadable));
+			Ar.Logf(TEXT("      %s"), ANSI_TO_TCHAR(HumanReadable));
+		}
+#endif
+	}
+
+	Ar.Logf(TEXT("========================================="));
+}
+
+bool FLyraAssetLoadTracker::IsDuringGameplay()
+{
+	if (GEngine == nullptr)
+	{
+		return false;
+	}
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		const UWorld* World = WorldContext.World();
+		if ((World == nullptr) || !World->IsGameWorld() || !World->HasBegunPlay())
+		{
+			continue;
+		}
+
+		// A hitch behind a loading screen is not visible to the player
+		const UGameInstance* GameInstance = World->GetGameInstance();
+		const ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr;
+		if ((LoadingScreenManager == nullptr) || !LoadingScreenManager->GetLoadingScreenDisplayStatus())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 FLyraAssetLoadTracker::FindCategory(const FSoftObjectPath& AssetPath) const
+{
+	const FString PackageName = AssetPath.GetLongPackageName();
+	for (int32 CategoryIndex = 0; CategoryIndex < Categories.Num(); ++CategoryIndex)
+	{
+		for (const FString& PathPrefix : Categories[CategoryIndex].PathPrefixes)
+		{
+			if (PackageName.StartsWith(PathPrefix))
+			{
+				return CategoryIndex;
+			}
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int64 FLyraAssetLoadTracker::GetCategoryUsage(int32 CategoryIndex) const
+{
+	int64 UsageBytes = 0;
+	for (const FKeptAsset& KeptAsset : KeptAssetsByCategory[CategoryIndex])
+	{
+		if (KeptAsset.Asset.IsValid())
+		{
+			UsageBytes += KeptAsset.EstimatedBytes;
+		}
+	}
+	return UsageBytes;
+}
+
+int64 FLyraAssetLoadTracker::EstimatePackageSize(FName PackageName)
+{
+	// The on-disk size is only an estimate of the memory cost, but it is cheap and consistent between runs
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		if (const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName))
+		{
+			return FMath::Max<int64>(PackageData->DiskSize, 0);
+		}
+	}
+	return 0;
+}
+
+void FLyraAssetLoadTracker::CaptureCallStack(TArray<uint64>& OutCallStack)
+{
+#if LYRA_ASSET_LOAD_CALLSTACKS
+	uint64 BackTrace[LyraAssetLoadTracking::MaxCallStackDepth + LyraAssetLoadTracking::CallStackFramesToSkip];
+	const uint32 Depth = FPlatformStackWalk::CaptureStackBackTrace(BackTrace, UE_ARRAY_COUNT(BackTrace));
+
+	OutCallStack.Reset();
+	for (uint32 FrameIndex = LyraAssetLoadTracking::CallStackFramesToSkip; FrameIndex < Depth; ++FrameIndex)
+	{
+		if (BackTrace[FrameIndex] != 0)
+		{
+			OutCallStack.Add(BackTrace[FrameIndex]);
+		}
+	}
+#endif
+}
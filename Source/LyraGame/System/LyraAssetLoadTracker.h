@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include "LyraAssetLoadTracker.generated.h"
+
+class FOutputDevice;
+struct FStreamableHandle;
+
+#define LYRA_ASSET_LOAD_CALLSTACKS !UE_BUILD_SHIPPING
+
+/** A group of assets (by path) that shares a memory budget, configured on ULyraAssetManager */
+USTRUCT()
+struct FLyraAssetBudgetCategory
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName Name;
+
+	// Long package path prefixes that belong to this category, e.g. /Game/Characters/Cosmetics
+	UPROPERTY()
+	TArray<FString> PathPrefixes;
+
+	// Estimated (on-disk) size the tracked assets of this category may use, 0 means unlimited (and nothing gets cached)
+	UPROPERTY()
+	int32 BudgetMB = 0;
+};
+
+/**
+ * FLyraAssetLoadTracker
+ *
+ *	Records the sync and async loads that go through ULyraAssetManager: when, how long, estimated size and who asked.
+ *	Synchronous loads while a game world is playing (and no loading screen is up) are flagged as hitch risks.
+ *	Also keeps per category usage so the asset manager knows which of its cached assets to let go of once a category is over budget.
+ */
+class FLyraAssetLoadTracker
+{
+public:
+	FLyraAssetLoadTracker();
+	~FLyraAssetLoadTracker();
+
+	void SetBudgetCategories(const TArray<FLyraAssetBudgetCategory>& InCategories);
+
+	// Records a finished synchronous load
+	void RecordSyncLoad(const FSoftObjectPath& AssetPath, double StartTime, double Duration, const UObject* LoadedAsset);
+
+	// Starts watching an async load, it gets recorded once the handle completes
+	void TrackAsyncLoad(const TSharedPtr<FStreamableHandle>& Handle, const FString& DebugName);
+
+	// The asset manager is keeping this asset alive, it counts against its category until it is evicted or collected.
+	// Pinned assets were requested with bKeepInMemory and are never evicted. Returns false if the asset
+	// is not in a category with a budget, unpinned assets like that should not be cached at all.
+	bool NotifyKeptInMemory(const UObject* Asset, bool bPinned);
+
+	// Picks cached (unpinned) assets to let go of, oldest first, so every category gets back under its budget
+	void GatherEvictions(TArray<const UObject*>& OutAssetsToEvict);
+
+	void Dump(FOutputDevice& Ar) const;
+
+	// Returns true if a game world is running and no loading screen is hiding a hitch
+	static bool IsDuringGameplay();
+
+private:
+	struct FLoadRecord
+	{
+		FSoftObjectPath AssetPath;
+		FString RequestName;
+		double StartTime = 0.0;
+		double Duration = 0.0;
+		int64 EstimatedBytes = 0;
+		int32 CategoryIndex = INDEX_NONE;
+		bool bSynchronous = false;
+		bool bHitchRisk = false;
+#if LYRA_ASSET_LOAD_CALLSTACKS
+		TArray<uint64> CallStack;
+#endif
+	};
+
+	struct FPendingAsyncLoad
+	{
+		TWeakPtr<FStreamableHandle> Handle;
+		FString DebugName;
+		double StartTime = 0.0;
+#if LYRA_ASSET_LOAD_CALLSTACKS
+		TArray<uint64> CallStack;
+#endif
+	};
+
+	struct FKeptAsset
+	{
+		TWeakObjectPtr<const UObject> Asset;
+		int64 EstimatedBytes = 0;
+		double KeptTime = 0.0;
+		bool bPinned = false;
+	};
+
+	bool Tick(float DeltaTime);
+
+	void AddRecord(FLoadRecord&& Record);
+	int32 FindCategory(const FSoftObjectPath& AssetPath) const;
+	int64 GetCategoryUsage(int32 CategoryIndex) const;
+
+	static int64 EstimatePackageSize(FName PackageName);
+	static void CaptureCallStack(TArray<uint64>& OutCallStack);
+
+	mutable FCriticalSection Lock;
+
+	TArray<FLyraAssetBudgetCategory> Categories;
+
+	// Ring buffer of the most recent loads, NextRecordIndex is the slot of the oldest record once it is full
+	TArray<FLoadRecord> Records;
+	int32 NextRecordIndex = 0;
+
+	TArray<FPendingAsyncLoad> PendingAsyncLoads;
+
+	// Kept-in-memory assets per category, indexed like Categories
+	TArray<TArray<FKeptAsset>> KeptAssetsByCategory;
+
+	int32 TotalSyncLoads = 0;
+	int32 TotalAsyncLoads = 0;
+	int32 TotalHitchRisks = 0;
+	double TotalSyncLoadSeconds = 0.0;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
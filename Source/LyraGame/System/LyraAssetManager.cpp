@@ -12,6 +12,7 @@
 #include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Misc/ScopedSlowTask.h"
 #include "System/LyraAssetManagerStartupJob.h"
+#include "Tasks/Task.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAssetManager)
 
@@ -25,9 +26,33 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 	FConsoleCommandDelegate::CreateStatic(ULyraAssetManager::DumpLoadedAssets)
 );
 
+static FAutoConsoleCommand CVarDumpAssetLoads(
+	TEXT("Lyra.AssetLoads.Dump"),
+	TEXT("Shows the slowest recent asset loads, synchronous loads during gameplay and memory budget usage per category."),
+	FConsoleCommandDelegate::CreateStatic(ULyraAssetManager::DumpAssetLoads)
+);
+
+static FAutoConsoleCommand CVarEnforceAssetBudgets(
+	TEXT("Lyra.AssetLoads.EnforceBudgets"),
+	TEXT("Releases cached assets from categories that are over their memory budget. This also runs before every garbage collection."),
+	FConsoleCommandDelegate::CreateLambda([]() { ULyraAssetManager::Get().EnforceAssetBudgets(); })
+);
+
+//////////////////////////////////////////////////////////////////////
+
+namespace LyraAssetManagerCVars
+{
+	static bool EnableParallelStartupJobs = true;
+	static FAutoConsoleVariableRef CVarEnableParallelStartupJobs(
+		TEXT("Lyra.AssetManager.EnableParallelStartupJobs"),
+		EnableParallelStartupJobs,
+		TEXT("Lets independent startup jobs overlap: any thread jobs run on the task graph and async loads are only waited on when a dependent job needs them. Read during engine init, so set it with -dpcvars or an ini"),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) AddStartupJob(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
 //////////////////////////////////////////////////////////////////////
@@ -63,13 +88,28 @@ UObject* ULyraAssetManager::SynchronousLoadAsset(const FSoftObjectPath& AssetPat
 			LogTimePtr = MakeUnique<FScopeLogTime>(*FString::Printf(TEXT("Synchronously loaded asset [%s]"), *AssetPath.ToString()), nullptr, FScopeLogTime::ScopeLog_Seconds);
 		}
 
+		const double StartTime = FPlatformTime::Seconds();
+
+		UObject* LoadedAsset = nullptr;
 		if (UAssetManager::Get().IsInitialized())
 		{
-			return UAssetManager::GetStreamableManager().LoadSynchronous(AssetPath, false);
+			LoadedAsset = UAssetManager::GetStreamableManager().LoadSynchronous(AssetPath, false);
+		}
+		else
+		{
+			// Use LoadObject if asset manager isn't ready yet.
+			LoadedAsset = AssetPath.TryLoad();
+		}
+
+		if (ULyraAssetManager* LyraAssetManager = Cast<ULyraAssetManager>(GEngine ? GEngine->AssetManager : nullptr))
+		{
+			if (LyraAssetManager->LoadTracker.IsValid())
+			{
+				LyraAssetManager->LoadTracker->RecordSyncLoad(AssetPath, StartTime, FPlatformTime::Seconds() - StartTime, LoadedAsset);
+			}
 		}
 
-		// Use LoadObject if asset manager isn't ready yet.
-		return AssetPath.TryLoad();
+		return LoadedAsset;
 	}
 
 	return nullptr;
@@ -84,9 +124,77 @@ bool ULyraAssetManager::ShouldLogAssetLoads()
 void ULyraAssetManager::AddLoadedAsset(const UObject* Asset)
 {
 	if (ensureAlways(Asset))
+	{
+		bool bAlreadyLoaded = false;
+		{
+			FScopeLock LoadedAssetsLock(&LoadedAssetsCritical);
+			LoadedAssets.Add(Asset, &bAlreadyLoaded);
+			CachedAssets.Remove(Asset);
+		}
+
+		// Counts against its budget category but is never evicted
+		if (!bAlreadyLoaded && LoadTracker.IsValid())
+		{
+			LoadTracker->NotifyKeptInMemory(Asset, /*bPinned=*/ true);
+		}
+	}
+}
+
+void ULyraAssetManager::AddCachedAsset(const UObject* Asset)
+{
+	if (ensureAlways(Asset) && LoadTracker.IsValid())
+	{
+		{
+			FScopeLock LoadedAssetsLock(&LoadedAssetsCritical);
+			if (LoadedAssets.Contains(Asset) || CachedAssets.Contains(Asset))
+			{
+				return;
+			}
+		}
+
+		// Only assets in a category with a budget are cached, everything else is left to GC as before
+		if (LoadTracker->NotifyKeptInMemory(Asset, /*bPinned=*/ false))
+		{
+			FScopeLock LoadedAssetsLock(&LoadedAssetsCritical);
+			CachedAssets.Add(Asset);
+		}
+	}
+}
+
+void ULyraAssetManager::TrackAsyncLoad(const TSharedPtr<FStreamableHandle>& Handle, const FString& DebugName)
+{
+	if (LoadTracker.IsValid())
+	{
+		LoadTracker->TrackAsyncLoad(Handle, DebugName);
+	}
+}
+
+void ULyraAssetManager::EnforceAssetBudgets()
+{
+	if (!LoadTracker.IsValid())
+	{
+		return;
+	}
+
+	TArray<const UObject*> AssetsToEvict;
+	LoadTracker->GatherEvictions(AssetsToEvict);
+
+	if (AssetsToEvict.Num() > 0)
 	{
 		FScopeLock LoadedAssetsLock(&LoadedAssetsCritical);
-		LoadedAssets.Add(Asset);
+		for (const UObject* Asset : AssetsToEvict)
+		{
+			CachedAssets.Remove(Asset);
+		}
+	}
+}
+
+void ULyraAssetManager::DumpAssetLoads()
+{
+	ULyraAssetManager& AssetManager = Get();
+	if (AssetManager.LoadTracker.IsValid())
+	{
+		AssetManager.LoadTracker->Dump(*GLog);
 	}
 }
 
@@ -100,6 +208,7 @@ void ULyraAssetManager::DumpLoadedAssets()
 	}
 
 	UE_LOG(LogLyra, Log, TEXT("... %d assets in loaded pool"), Get().LoadedAssets.Num());
+	UE_LOG(LogLyra, Log, TEXT("... %d assets cached within their budgets"), Get().CachedAssets.Num());
 	UE_LOG(LogLyra, Log, TEXT("========== Finish Dumping Loaded Assets =========="));
 }
 
@@ -110,14 +219,24 @@ void ULyraAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
-	STARTUP_JOB(InitializeAbilitySystem());
-	STARTUP_JOB(InitializeGameplayCueManager());
+	LoadTracker = MakeUnique<FLyraAssetLoadTracker>();
+	LoadTracker->SetBudgetCategories(AssetBudgetCategories);
+
+	// Evicting only makes a difference at the next GC, so that is when budgets get enforced
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &ThisClass::EnforceAssetBudgets);
+
+	const int32 AbilitySystemJob = STARTUP_JOB(InitializeAbilitySystem()).JobId;
+	STARTUP_JOB(InitializeGameplayCueManager()).DependsOn(AbilitySystemJob);
 
 	// Only try to load GameData if the path is configured
 	if (!LyraGameDataPath.IsNull())
 	{
+		// Start streaming the game data in as soon as the ability system globals exist (game data references gameplay effects),
+		// the gameplay cue manager setup then overlaps with the load
+		const int32 GameDataLoadJob = STARTUP_JOB_WEIGHTED(StartGameDataLoad(LoadHandle), 20.f).DependsOn(AbilitySystemJob).JobId;
+
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		STARTUP_JOB_WEIGHTED(GetGameData(), 5.f).DependsOn(GameDataLoadJob);
 	}
 	else
 	{
@@ -145,6 +264,16 @@ void ULyraAssetManager::InitializeGameplayCueManager()
 }
 
 
+void ULyraAssetManager::StartGameDataLoad(TSharedPtr<FStreamableHandle>& OutLoadHandle)
+{
+	// The editor may already be loading this recursively from PostLoad, let GetGameData do its synchronous load there
+	if (!GIsEditor && !GameDataMap.Contains(ULyraGameData::StaticClass()))
+	{
+		OutLoadHandle = LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+		TrackAsyncLoad(OutLoadHandle, TEXT("GameData"));
+	}
+}
+
 const ULyraGameData& ULyraAssetManager::GetGameData()
 {
 	// Check if we have a valid path configured
@@ -226,59 +355,269 @@ UPrimaryDataAsset* ULyraAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryDa
 }
 
 
+FLyraAssetManagerStartupJob& ULyraAssetManager::AddStartupJob(FLyraAssetManagerStartupJob&& StartupJob)
+{
+	StartupJob.JobId = StartupJobs.Num();
+	return StartupJobs.Add_GetRef(MoveTemp(StartupJob));
+}
+
 void ULyraAssetManager::DoAllStartupJobs()
 {
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	// No need for progress updates on a dedicated server
+	const bool bReportProgress = !IsRunningDedicatedServer();
+	const bool bAllowOverlap = LyraAssetManagerCVars::EnableParallelStartupJobs;
+
+	if (StartupJobs.Num() > 0)
 	{
-		// No need for periodic progress updates, just run the jobs
+		enum class EJobState : uint8
+		{
+			Pending,
+			Running,
+			Complete
+		};
+
+		const int32 NumJobs = StartupJobs.Num();
+
+		TArray<EJobState> JobStates;
+		JobStates.Init(EJobState::Pending, NumJobs);
+		TArray<TSharedPtr<FStreamableHandle>> JobHandles;
+		JobHandles.SetNum(NumJobs);
+		TArray<UE::Tasks::FTask> JobTasks;
+		JobTasks.SetNum(NumJobs);
+		TArray<float> JobProgress;
+		JobProgress.Init(0.0f, NumJobs);
+
+		// Job ids are indices into StartupJobs, a job can only depend on jobs queued before it so the graph can't have cycles
+		TArray<TArray<int32>> JobDependencies;
+		JobDependencies.SetNum(NumJobs);
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			for (const int32 DependencyIndex : StartupJobs[JobIndex].Dependencies)
+			{
+				if (ensureMsgf(DependencyIndex >= 0 && DependencyIndex < JobIndex, TEXT("Startup job \"%s\" depends on invalid job id %d"), *StartupJobs[JobIndex].JobName, DependencyIndex))
+				{
+					JobDependencies[JobIndex].Add(DependencyIndex);
+				}
+			}
+		}
+
+		float TotalJobValue = 0.0f;
 		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
 		{
-			StartupJob.DoJob();
+			TotalJobValue += StartupJob.JobWeight;
 		}
-	}
-	else
-	{
-		if (StartupJobs.Num() > 0)
+
+		auto UpdateOverallProgress = [this, &JobStates, &JobProgress, TotalJobValue]()
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			float AccumulatedJobValue = 0.0f;
+			for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				const float JobFraction = (JobStates[JobIndex] == EJobState::Complete) ? 1.0f : JobProgress[JobIndex];
+				AccumulatedJobValue += JobFraction * StartupJobs[JobIndex].JobWeight;
 			}
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			UpdateInitialGameContentLoadPercent((TotalJobValue > 0.0f) ? (AccumulatedJobValue / TotalJobValue) : 1.0f);
+		};
+
+		if (bReportProgress)
+		{
+			for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				StartupJobs[JobIndex].SubstepProgressDelegate.BindLambda([&JobProgress, &UpdateOverallProgress, JobIndex](float NewProgress)
 					{
-						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
-
-						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
+						JobProgress[JobIndex] = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+						UpdateOverallProgress();
 					});
+			}
+		}
 
-				StartupJob.DoJob();
+		int32 NumCompleteJobs = 0;
+		while (NumCompleteJobs < NumJobs)
+		{
+			bool bMadeProgress = false;
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+			// Start everything whose dependencies are done. Without overlap only one job is in flight at a time, in declaration order.
+			const bool bAnyRunning = JobStates.Contains(EJobState::Running);
+			for (int32 JobIndex = 0; JobIndex < NumJobs && (bAllowOverlap || !bAnyRunning); ++JobIndex)
+			{
+				if (JobStates[JobIndex] != EJobState::Pending)
+				{
+					continue;
+				}
+
+				const bool bDependenciesComplete = !JobDependencies[JobIndex].ContainsByPredicate([&JobStates](int32 DependencyIndex) { return JobStates[DependencyIndex] != EJobState::Complete; });
+				if (!bDependenciesComplete)
+				{
+					if (!bAllowOverlap)
+					{
+						break;
+					}
+					continue;
+				}
+
+				const FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+				JobStates[JobIndex] = EJobState::Running;
+				bMadeProgress = true;
+
+				if (bAllowOverlap && StartupJob.Thread == ELyraStartupJobThread::AnyThread)
+				{
+					JobTasks[JobIndex] = UE::Tasks::Launch(*StartupJob.JobName, [&StartupJob, &JobHandle = JobHandles[JobIndex]]()
+						{
+							JobHandle = StartupJob.StartJob();
+						});
+				}
+				else
+				{
+					JobHandles[JobIndex] = StartupJob.StartJob();
+				}
+
+				if (!bAllowOverlap)
+				{
+					break;
+				}
+			}
 
-				AccumulatedJobValue += JobValue;
+			// Retire anything that has finished, including the load it kicked off
+			int32 WaitOnHandleIndex = INDEX_NONE;
+			for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+			{
+				if (JobStates[JobIndex] != EJobState::Running || !JobTasks[JobIndex].IsCompleted())
+				{
+					continue;
+				}
+
+				const TSharedPtr<FStreamableHandle>& Handle = JobHandles[JobIndex];
+				if (Handle.IsValid() && !Handle->HasLoadCompleted() && !Handle->WasCanceled())
+				{
+					if (WaitOnHandleIndex == INDEX_NONE)
+					{
+						WaitOnHandleIndex = JobIndex;
+					}
+					continue;
+				}
+
+				const FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+				if (Handle.IsValid())
+				{
+					Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
+				}
+
+				StartupJob.EndTime = FPlatformTime::Seconds();
+				UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *StartupJob.JobName, StartupJob.GetWallTime());
+
+				JobStates[JobIndex] = EJobState::Complete;
+				++NumCompleteJobs;
+				bMadeProgress = true;
+
+				if (bReportProgress)
+				{
+					UpdateOverallProgress();
+				}
+			}
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			if (!bMadeProgress && NumCompleteJobs < NumJobs)
+			{
+				if (WaitOnHandleIndex != INDEX_NONE)
+				{
+					// Pump async loading for a while so the outstanding loads keep moving
+					JobHandles[WaitOnHandleIndex]->WaitUntilComplete(0.05f, false);
+				}
+				else if (JobStates.Contains(EJobState::Running))
+				{
+					// Only task graph jobs are outstanding
+					FPlatformProcess::Sleep(0.0f);
+				}
+				else
+				{
+					UE_LOG(LogLyra, Error, TEXT("Startup jobs have a dependency cycle, %d jobs could not run"), NumJobs - NumCompleteJobs);
+					break;
+				}
 			}
 		}
-		else
+
+		for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			StartupJob.SubstepProgressDelegate.Unbind();
 		}
 	}
 
+	if (bReportProgress)
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
+	}
+
+	const double AllStartupJobsTime = FPlatformTime::Seconds() - AllStartupJobsStartTime;
+	LogStartupJobReport(AllStartupJobsTime);
+
 	StartupJobs.Empty();
 
-	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), AllStartupJobsTime);
+}
+
+void ULyraAssetManager::LogStartupJobReport(double TotalTime) const
+{
+	if (StartupJobs.Num() == 0)
+	{
+		return;
+	}
+
+	// The critical path is the dependency chain that finished last, walk it back from the last job to complete
+	int32 LastJobIndex = 0;
+	for (int32 JobIndex = 1; JobIndex < StartupJobs.Num(); ++JobIndex)
+	{
+		if (StartupJobs[JobIndex].EndTime > StartupJobs[LastJobIndex].EndTime)
+		{
+			LastJobIndex = JobIndex;
+		}
+	}
+
+	TArray<int32> CriticalPath;
+	for (int32 JobIndex = LastJobIndex; JobIndex != INDEX_NONE && !CriticalPath.Contains(JobIndex);)
+	{
+		CriticalPath.Insert(JobIndex, 0);
+
+		int32 LatestDependency = INDEX_NONE;
+		for (const int32 DependencyIndex : StartupJobs[JobIndex].Dependencies)
+		{
+			if (StartupJobs.IsValidIndex(DependencyIndex) && (LatestDependency == INDEX_NONE || StartupJobs[DependencyIndex].EndTime > StartupJobs[LatestDependency].EndTime))
+			{
+				LatestDependency = DependencyIndex;
+			}
+		}
+		JobIndex = LatestDependency;
+	}
+
+	double SumOfJobTimes = 0.0;
+	UE_LOG(LogLyra, Display, TEXT("========== Startup Job Report =========="));
+	for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+	{
+		const FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+		SumOfJobTimes += StartupJob.GetWallTime();
+
+		UE_LOG(LogLyra, Display, TEXT("  %s %-40s %7.3fs (started at +%.3fs on %s)"),
+			CriticalPath.Contains(JobIndex) ? TEXT("*") : TEXT(" "),
+			*StartupJob.JobName,
+			StartupJob.GetWallTime(),
+			StartupJob.StartTime - StartupJobs[0].StartTime,
+			(StartupJob.Thread == ELyraStartupJobThread::AnyThread) ? TEXT("any thread") : TEXT("game thread"));
+	}
+
+	FString CriticalPathString;
+	for (int32 JobIndex : CriticalPath)
+	{
+		if (!CriticalPathString.IsEmpty())
+		{
+			CriticalPathString += TEXT(" -> ");
+		}
+		CriticalPathString += StartupJobs[JobIndex].JobName;
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("  Critical path (*): %s"), *CriticalPathString);
+	UE_LOG(LogLyra, Display, TEXT("  Total %.3fs, serial sum of job times %.3fs"), TotalTime, SumOfJobTimes);
+	UE_LOG(LogLyra, Display, TEXT("========================================"));
 }
 
 void ULyraAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
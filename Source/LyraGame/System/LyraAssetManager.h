@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/AssetManager.h"
+#include "LyraAssetLoadTracker.h"
 #include "LyraAssetManagerStartupJob.h"
 #include "LyraLogChannels.h"
 #include "Templates/SubclassOf.h"
@@ -13,7 +14,7 @@ class UPrimaryDataAsset;
 class ULyraGameData;
 class ULyraPawnData;
 
-struct FLyraBundles
+struct LYRAGAME_API FLyraBundles
 {
 	static const FName Equipped;
 };
@@ -49,6 +50,16 @@ public:
 	// Logs all assets currently loaded and tracked by the asset manager.
 	static void DumpLoadedAssets();
 
+	// Logs recent sync/async loads, hitch risks and per-category budget usage.
+	static void DumpAssetLoads();
+
+	// Records an async load with the load tracker once the handle completes, DebugName should say who asked for it.
+	void TrackAsyncLoad(const TSharedPtr<FStreamableHandle>& Handle, const FString& DebugName);
+
+	// Drops cached assets from categories that are over their memory budget, they are freed by the next GC if nothing else references them.
+	// Assets requested with bKeepInMemory are never dropped. Runs right before every garbage collection.
+	void EnforceAssetBudgets();
+
 	const ULyraGameData& GetGameData();
 	const ULyraPawnData* GetDefaultPawnData() const;
 
@@ -72,6 +83,9 @@ protected:
 	// Thread safe way of adding a loaded asset to keep in memory.
 	void AddLoadedAsset(const UObject* Asset);
 
+	// Thread safe way of keeping an asset loaded without bKeepInMemory around while its budget category has room.
+	void AddCachedAsset(const UObject* Asset);
+
 	//~UAssetManager interface
 	virtual void StartInitialLoading() override;
 #if WITH_EDITOR
@@ -95,10 +109,24 @@ protected:
 	UPROPERTY(Config)
 	TSoftObjectPtr<ULyraPawnData> DefaultPawnData;
 
+	// Memory budgets for assets loaded by GetAsset/GetSubclass, matched by package path.
+	// Assets loaded without bKeepInMemory are cached within these budgets.
+	UPROPERTY(Config)
+	TArray<FLyraAssetBudgetCategory> AssetBudgetCategories;
+
 private:
+	// Queues a job for DoAllStartupJobs and assigns its id
+	FLyraAssetManagerStartupJob& AddStartupJob(FLyraAssetManagerStartupJob&& StartupJob);
+
 	// Flushes the StartupJobs array. Processes all startup work.
 	void DoAllStartupJobs();
 
+	// Logs each startup job's wall time and the chain of dependencies that bounded the total startup time
+	void LogStartupJobReport(double TotalTime) const;
+
+	// Kicks off the async load of the game data so it can stream in while other startup jobs run
+	void StartGameDataLoad(TSharedPtr<FStreamableHandle>& OutLoadHandle);
+
 	// Sets up the ability system
 	void InitializeAbilitySystem();
 	void InitializeGameplayCueManager();
@@ -115,8 +143,15 @@ private:
 	UPROPERTY()
 	TSet<TObjectPtr<const UObject>> LoadedAssets;
 
+	// Assets loaded without bKeepInMemory that stay around until their budget category needs the room.
+	UPROPERTY()
+	TSet<TObjectPtr<const UObject>> CachedAssets;
+
 	// Used for a scope lock when modifying the list of load assets.
 	FCriticalSection LoadedAssetsCritical;
+
+	// Records loads going through the asset manager and tracks category budgets.
+	TUniquePtr<FLyraAssetLoadTracker> LoadTracker;
 };
 
 
@@ -144,6 +179,11 @@ AssetType* ULyraAssetManager::GetAsset(const TSoftObjectPtr<AssetType>& AssetPoi
 			// Added to loaded asset list.
 			Get().AddLoadedAsset(Cast<UObject>(LoadedAsset));
 		}
+		else if (LoadedAsset)
+		{
+			// Cached until its budget category needs the room.
+			Get().AddCachedAsset(Cast<UObject>(LoadedAsset));
+		}
 	}
 
 	return LoadedAsset;
@@ -173,6 +213,11 @@ TSubclassOf<AssetType> ULyraAssetManager::GetSubclass(const TSoftClassPtr<AssetT
 			// Added to loaded asset list.
 			Get().AddLoadedAsset(Cast<UObject>(LoadedSubclass));
 		}
+		else if (LoadedSubclass)
+		{
+			// Cached until its budget category needs the room.
+			Get().AddCachedAsset(Cast<UObject>(LoadedSubclass));
+		}
 	}
 
 	return LoadedSubclass;
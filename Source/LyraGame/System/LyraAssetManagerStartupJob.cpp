@@ -23,3 +23,19 @@ TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
 
 	return Handle;
 }
+
+TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::StartJob() const
+{
+	StartTime = FPlatformTime::Seconds();
+
+	TSharedPtr<FStreamableHandle> Handle;
+	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
+	JobFunc(*this, Handle);
+
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
+	{
+		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
+	}
+
+	return Handle;
+}
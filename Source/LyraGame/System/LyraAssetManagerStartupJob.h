@@ -6,6 +6,16 @@
 
 DECLARE_DELEGATE_OneParam(FLyraAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
 
+/** Where a startup job is allowed to run */
+enum class ELyraStartupJobThread : uint8
+{
+	// Touches UObjects or engine singletons, must run on the game thread
+	GameThread,
+
+	// Pure work that can run on any task graph worker
+	AnyThread
+};
+
 /** Handles reporting progress from streamable handles */
 struct FLyraAssetManagerStartupJob
 {
@@ -15,6 +25,18 @@ struct FLyraAssetManagerStartupJob
 	float JobWeight;
 	mutable double LastUpdate = 0;
 
+	/** Assigned when the job is queued on the asset manager, other jobs use it to depend on this one */
+	int32 JobId = INDEX_NONE;
+
+	/** Ids of the jobs that have to be complete (including any load they started) before this one can start */
+	TArray<int32> Dependencies;
+
+	ELyraStartupJobThread Thread = ELyraStartupJobThread::GameThread;
+
+	/** Wall clock times recorded by the scheduler, EndTime includes waiting on the returned streamable handle */
+	mutable double StartTime = 0.0;
+	mutable double EndTime = 0.0;
+
 	/** Simple job that is all synchronous */
 	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
@@ -22,9 +44,27 @@ struct FLyraAssetManagerStartupJob
 		, JobWeight(InJobWeight)
 	{}
 
+	FLyraAssetManagerStartupJob& DependsOn(int32 OtherJobId)
+	{
+		check(OtherJobId != INDEX_NONE);
+		Dependencies.Add(OtherJobId);
+		return *this;
+	}
+
+	FLyraAssetManagerStartupJob& RunOn(ELyraStartupJobThread InThread)
+	{
+		Thread = InThread;
+		return *this;
+	}
+
 	/** Perform actual loading, will return a handle if it created one */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** Runs the job function without waiting on the handle it returns, the scheduler is responsible for waiting */
+	TSharedPtr<FStreamableHandle> StartJob() const;
+
+	double GetWallTime() const { return EndTime - StartTime; }
+
 	void UpdateSubstepProgress(float NewProgress) const
 	{
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
@@ -79,6 +79,12 @@
 *		
 *		Lyra.RepGraph.PrintRouting - will print the EClassRepNodeMapping for each class. That is, how a given actor class is routed (or not) in the Replication Graph.
 *	
+*	Measuring Server Cost
+*	
+*		Launch the same dedicated server twice, once normally and once with -NoLyraRepGraph (which falls back to the default net driver relevancy path), connect the
+*		same number of headless clients (-nullrhi) to each and record a CSV profile (-csvprofile or "CsvProfile Start/Stop"). Compare the ServerReplicateActors
+*		timings between the two captures.
+*	
 */
 
 #include "LyraReplicationGraph.h"
@@ -101,8 +107,12 @@
 #include "UObject/UObjectIterator.h"
 
 #include "LyraReplicationGraphSettings.h"
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
 #include "Character/LyraCharacter.h"
+#include "Messages/LyraVerbMessage.h"
 #include "Player/LyraPlayerController.h"
+#include "Teams/LyraTeamSubsystem.h"
+#include "Weapons/LyraWeaponSpawner.h"
 
 DEFINE_LOG_CATEGORY( LogLyraRepGraph );
 
@@ -145,6 +155,22 @@ namespace Lyra::RepGraph
 	int32 EnableFastSharedPath = 1;
 	static FAutoConsoleVariableRef CVarLyraRepEnableFastSharedPath(TEXT("Lyra.RepGraph.EnableFastSharedPath"), EnableFastSharedPath, TEXT(""), ECVF_Default);
 
+	// When enabled, dynamic actors in each grid cell (player and AI pawns mostly) replicate less frequently the further they are from a connection's viewer.
+	bool bEnableDynamicSpatialFrequency = true;
+	static FAutoConsoleVariableRef CVarLyraRepEnableDynamicSpatialFrequency(TEXT("Lyra.RepGraph.EnableDynamicSpatialFrequency"), bEnableDynamicSpatialFrequency, TEXT("Use distance based replication frequency for dynamic spatialized actors. Only applies when the graph is created."), ECVF_Default);
+
+	// How long two players keep prioritizing each other's player state after exchanging damage.
+	float PlayerStateCombatWindow = 5.f;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateCombatWindow(TEXT("Lyra.RepGraph.PlayerState.CombatWindow"), PlayerStateCombatWindow, TEXT("Seconds during which enemies that exchanged damage replicate their player states to each other every frame"), ECVF_Default);
+
+	// Upper bound on the combat partner and team mate player states returned to a connection per frame, on top of the rolling buckets.
+	int32 PlayerStatePriorityActorsPerFrame = 2;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStatePriorityActorsPerFrame(TEXT("Lyra.RepGraph.PlayerState.PriorityActorsPerFrame"), PlayerStatePriorityActorsPerFrame, TEXT("Max combat partner and team mate player states returned to each connection per frame, in addition to the rolling player state buckets"), ECVF_Default);
+
+	// How often (in frames) team lists and per connection team/combat lists are rebuilt. New damage exchanges are picked up immediately.
+	int32 PlayerStateRefreshFrames = 30;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateRefreshFrames(TEXT("Lyra.RepGraph.PlayerState.RefreshFrames"), PlayerStateRefreshFrames, TEXT("How often, in replication frames, player state team lists and per connection priority lists are rebuilt"), ECVF_Default);
+
 	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
 	{
 		// Only create for GameNetDriver
@@ -159,6 +185,13 @@ namespace Lyra::RepGraph
 				return nullptr;
 			}
 
+			// Allows comparing against the default relevancy path with the same build and config (see "Measuring Server Cost" above)
+			if (FParse::Param(FCommandLine::Get(), TEXT("NoLyraRepGraph")))
+			{
+				UE_LOG(LogLyraRepGraph, Display, TEXT("Replication graph is disabled via -NoLyraRepGraph."));
+				return nullptr;
+			}
+
 			UE_LOG(LogLyraRepGraph, Display, TEXT("Replication graph is enabled for %s in world %s."), *GetNameSafe(ForNetDriver), *GetPathNameSafe(World));
 
 			TSubclassOf<ULyraReplicationGraph> GraphClass = LyraRepGraphSettings->DefaultReplicationGraphClass.TryLoadClass<ULyraReplicationGraph>();
@@ -399,6 +432,9 @@ void ULyraReplicationGraph::InitGlobalActorClassSettings()
 	AddClassRepInfo(AGameplayDebuggerCategoryReplicator::StaticClass(), EClassRepNodeMapping::NotRouted);				// Replicated via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection
 #endif
 
+	// Weapon spawners never move and stay dormant until picked up or respawned, so they don't need per frame gathering
+	AddClassRepInfo(ALyraWeaponSpawner::StaticClass(), EClassRepNodeMapping::Spatialize_Static);
+
 	TArray<UClass*> AllReplicatedClasses;
 
 	for (TObjectIterator<UClass> It; It; ++It)
@@ -556,6 +592,21 @@ void ULyraReplicationGraph::InitGlobalGraphNodes()
 	{
 		GridNode->AddToClassRebuildDenyList(AActor::StaticClass()); // Disable All spatial rebuilding
 	}
+
+	if (Lyra::RepGraph::bEnableDynamicSpatialFrequency)
+	{
+		// Dynamic actors (player and AI pawns) go into a node that picks their replication period based on distance and view direction
+		// for each connection, so far away bots in AI heavy matches cost less than the ones right in front of a player
+		GridNode->CreateCellNodeOverride = [](UReplicationGraphNode_GridSpatialization2D* Parent) -> UReplicationGraphNode_GridCell*
+		{
+			UReplicationGraphNode_GridCell* CellNode = Parent->CreateChildNode<UReplicationGraphNode_GridCell>();
+			CellNode->CreateDynamicNodeOverride = [](UReplicationGraphNode_GridCell* ParentCell) -> UReplicationGraphNode*
+			{
+				return ParentCell->CreateChildNode<UReplicationGraphNode_DynamicSpatialFrequency>();
+			};
+			return CellNode;
+		};
+	}
 	
 	AddGlobalGraphNode(GridNode);
 
@@ -568,7 +619,7 @@ void ULyraReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
 }
 
@@ -594,6 +645,12 @@ EClassRepNodeMapping ULyraReplicationGraph::GetMappingPolicy(UClass* Class)
 
 void ULyraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
 {
+	// Player states are not routed to the other nodes, but the frequency limiter keeps its own list of them
+	if (ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+	{
+		PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+	}
+
 	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
 	switch(Policy)
 	{
@@ -638,6 +695,11 @@ void ULyraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActo
 
 void ULyraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
 {
+	if (ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+	{
+		PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+
 	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
 	switch(Policy)
 	{
@@ -890,26 +952,152 @@ void ULyraReplicationGraphNode_AlwaysRelevant_ForConnection::LogNode(FReplicatio
 
 // ------------------------------------------------------------------------------
 
+namespace Lyra::RepGraph
+{
+	// Returns the player state an object acts on behalf of (pawns, controllers, and actors instigated by a pawn)
+	static APlayerState* GetPlayerStateForReplicationPriority(const UObject* Object)
+	{
+		if (const APlayerState* PS = Cast<const APlayerState>(Object))
+		{
+			return const_cast<APlayerState*>(PS);
+		}
+		else if (const APawn* Pawn = Cast<const APawn>(Object))
+		{
+			return Pawn->GetPlayerState();
+		}
+		else if (const AController* Controller = Cast<const AController>(Object))
+		{
+			return Controller->PlayerState;
+		}
+		else if (const AActor* Actor = Cast<const AActor>(Object))
+		{
+			if (const APawn* InstigatorPawn = Actor->GetInstigator())
+			{
+				return InstigatorPawn->GetPlayerState();
+			}
+		}
+
+		return nullptr;
+	}
+};
+
 ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::ULyraReplicationGraphNode_PlayerStateFrequencyLimiter()
 {
 	bRequiresPrepareForReplicationCall = true;
 }
 
-void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (AllPlayerStates.Contains(ActorInfo.Actor) == false)
+	{
+		AllPlayerStates.Add(ActorInfo.Actor);
+		bBucketsDirty = true;
+		FramesUntilTeamRefresh = 0;
+	}
+}
+
+bool ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
 {
+	const bool bRemoved = AllPlayerStates.RemoveFast(ActorInfo.Actor);
+	if (bRemoved)
+	{
+		// Make sure no list keeps referencing the actor, the buckets are rebuilt before the next gather
+		bBucketsDirty = true;
+		FramesUntilTeamRefresh = 0;
+
+		for (auto& KVP : TeamLists)
+		{
+			KVP.Value.RemoveFast(ActorInfo.Actor);
+		}
+
+		for (auto& KVP : ConnectionPriorityInfos)
+		{
+			KVP.Value.CombatList.RemoveFast(ActorInfo.Actor);
+			KVP.Value.PriorityList.RemoveFast(ActorInfo.Actor);
+		}
+	}
+	else
+	{
+		UE_CLOG(bWarnIfNotFound, LogLyraRepGraph, Warning, TEXT("Player state %s was not found in %s"), *GetActorRepListTypeDebugString(ActorInfo.Actor), *GetName());
+	}
+
+	return bRemoved;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	AllPlayerStates.Reset();
 	ReplicationActorLists.Reset();
 	ForceNetUpdateReplicationActorList.Reset();
+	TeamLists.Reset();
+	RecentCombatTimes.Reset();
+	ConnectionPriorityInfos.Reset();
+	bBucketsDirty = true;
+	FramesUntilTeamRefresh = 0;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::BeginDestroy()
+{
+	DamageListenerHandle.Unregister();
+
+	Super::BeginDestroy();
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::RegisterForDamageMessages()
+{
+	UWorld* World = GetWorld();
+	if (World != DamageListenerWorld.Get())
+	{
+		DamageListenerHandle.Unregister();
+		DamageListenerWorld = World;
+
+		if ((World != nullptr) && (World->GetGameInstance() != nullptr))
+		{
+			UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(World);
+			DamageListenerHandle = MessageSubsystem.RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
+{
+	const APlayerState* InstigatorPS = Lyra::RepGraph::GetPlayerStateForReplicationPriority(Payload.Instigator);
+	const APlayerState* TargetPS = Lyra::RepGraph::GetPlayerStateForReplicationPriority(Payload.Target);
+
+	if ((InstigatorPS != nullptr) && (TargetPS != nullptr) && (InstigatorPS != TargetPS))
+	{
+		const double Now = GetWorld()->GetTimeSeconds();
+		const FObjectKey InstigatorKey(InstigatorPS);
+		const FObjectKey TargetKey(TargetPS);
+
+		// Both sides care about each other's player state (score, health related stats, etc...)
+		RecentCombatTimes.Add(MakeTuple(InstigatorKey, TargetKey), Now);
+		RecentCombatTimes.Add(MakeTuple(TargetKey, InstigatorKey), Now);
+
+		// Start prioritizing right away instead of waiting for the connections' next periodic refresh
+		for (auto& KVP : ConnectionPriorityInfos)
+		{
+			FConnectionPriorityInfo& Info = KVP.Value;
+			const APlayerState* OtherPS = (Info.ViewerPlayerState == InstigatorKey) ? TargetPS : ((Info.ViewerPlayerState == TargetKey) ? InstigatorPS : nullptr);
+			AActor* OtherActor = const_cast<APlayerState*>(OtherPS);
+			if ((OtherActor != nullptr) && AllPlayerStates.Contains(OtherActor) && !Info.CombatList.Contains(OtherActor))
+			{
+				Info.CombatList.Add(OtherActor);
+			}
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildBuckets()
+{
+	ReplicationActorLists.Reset();
 
 	ReplicationActorLists.AddDefaulted();
 	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
-
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	for (FActorRepListType Actor : AllPlayerStates)
 	{
-		APlayerState* PS = *It;
-		if (IsActorValidForReplicationGather(PS) == false)
+		if (IsActorValidForReplicationGather(Actor) == false)
 		{
 			continue;
 		}
@@ -920,19 +1108,176 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplicatio
 			CurrentList = &ReplicationActorLists.Last(); 
 		}
 		
-		CurrentList->Add(PS);
-	}	
+		CurrentList->Add(Actor);
+	}
+
+	bBucketsDirty = false;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	RegisterForDamageMessages();
+
+	ForceNetUpdateReplicationActorList.Reset();
+
+	// Team assignments and gather validity rarely change, so they are refreshed periodically instead of every frame
+	if (--FramesUntilTeamRefresh <= 0)
+	{
+		FramesUntilTeamRefresh = FMath::Max(1, Lyra::RepGraph::PlayerStateRefreshFrames);
+		bBucketsDirty = true;
+
+		TeamLists.Reset();
+		if (const ULyraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<ULyraTeamSubsystem>(GetWorld()))
+		{
+			for (FActorRepListType Actor : AllPlayerStates)
+			{
+				const int32 TeamId = TeamSubsystem->FindTeamFromObject(Actor);
+				if (TeamId != INDEX_NONE)
+				{
+					TeamLists.FindOrAdd(TeamId).Add(Actor);
+				}
+			}
+		}
+
+		if (const UWorld* World = GetWorld())
+		{
+			const double ExpireTime = World->GetTimeSeconds() - Lyra::RepGraph::PlayerStateCombatWindow;
+			for (auto It = RecentCombatTimes.CreateIterator(); It; ++It)
+			{
+				if (It.Value() < ExpireTime)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		for (auto It = ConnectionPriorityInfos.CreateIterator(); It; ++It)
+		{
+			if (It.Key().ResolveObjectPtr() == nullptr)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if (bBucketsDirty)
+	{
+		RebuildBuckets();
+	}
+}
+
+ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::FConnectionPriorityInfo& ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::RefreshConnectionPriority(const FConnectionGatherActorListParameters& Params)
+{
+	const FObjectKey ConnectionKey(&Params.ConnectionManager);
+
+	bool bIsNewConnection = false;
+	FConnectionPriorityInfo* Info = ConnectionPriorityInfos.Find(ConnectionKey);
+	if (Info == nullptr)
+	{
+		Info = &ConnectionPriorityInfos.Add(ConnectionKey);
+		bIsNewConnection = true;
+	}
+
+	// Spread the refresh of each connection's priority list across frames
+	const int32 RefreshFrames = FMath::Max(1, Lyra::RepGraph::PlayerStateRefreshFrames);
+	if (!bIsNewConnection && (((Params.ReplicationFrameNum + Params.ConnectionManager.ConnectionOrderNum) % RefreshFrames) != 0))
+	{
+		return *Info;
+	}
+
+	const APlayerState* ViewerPS = nullptr;
+	for (const FNetViewer& CurViewer : Params.Viewers)
+	{
+		if (const APlayerController* PC = Cast<APlayerController>(CurViewer.InViewer))
+		{
+			ViewerPS = PC->PlayerState;
+			break;
+		}
+	}
+
+	Info->CombatList.Reset();
+	Info->TeamId = INDEX_NONE;
+	Info->ViewerPlayerState = FObjectKey(ViewerPS);
+
+	if (ViewerPS != nullptr)
+	{
+		if (const ULyraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<ULyraTeamSubsystem>(GetWorld()))
+		{
+			Info->TeamId = TeamSubsystem->FindTeamFromObject(ViewerPS);
+		}
+
+		const FObjectKey ViewerKey(ViewerPS);
+		const double ExpireTime = GetWorld()->GetTimeSeconds() - Lyra::RepGraph::PlayerStateCombatWindow;
+		for (const auto& KVP : RecentCombatTimes)
+		{
+			if ((KVP.Key.Key == ViewerKey) && (KVP.Value >= ExpireTime))
+			{
+				AActor* OtherPS = Cast<AActor>(KVP.Key.Value.ResolveObjectPtr());
+				if ((OtherPS != nullptr) && AllPlayerStates.Contains(OtherPS))
+				{
+					Info->CombatList.Add(OtherPS);
+				}
+			}
+		}
+	}
+
+	return *Info;
 }
 
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
+	FConnectionPriorityInfo& Info = RefreshConnectionPriority(Params);
+
 	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
 	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+	int64 NumGathered = ReplicationActorLists[ListIdx].Num();
+
+	// On top of the rolling buckets, return up to PriorityActorsPerFrame player states that matter to this connection.
+	// Enemies we're fighting come first, team mates fill whatever is left. Both lists are walked with a cursor so everyone
+	// in them gets a turn when they don't fit in one frame.
+	int32 Budget = FMath::Max(1, Lyra::RepGraph::PlayerStatePriorityActorsPerFrame);
+	Info.PriorityList.Reset();
+
+	auto AddFromList = [&Info, &Budget](const FActorRepListRefView& List, int32& Cursor)
+	{
+		const int32 NumToAdd = FMath::Min(Budget, List.Num());
+		for (int32 i = 0; i < NumToAdd; ++i)
+		{
+			Cursor = (Cursor + 1) % List.Num();
+			Info.PriorityList.Add(List[Cursor]);
+		}
+		Budget -= NumToAdd;
+	};
+
+	if (Info.CombatList.Num() > 0)
+	{
+		AddFromList(Info.CombatList, Info.CombatCursor);
+	}
+
+	if ((Budget > 0) && (Info.TeamId != INDEX_NONE))
+	{
+		if (const FActorRepListRefView* TeamList = TeamLists.Find(Info.TeamId))
+		{
+			if (TeamList->Num() > 0)
+			{
+				AddFromList(*TeamList, Info.TeamCursor);
+			}
+		}
+	}
+
+	if (Info.PriorityList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(Info.PriorityList);
+		NumGathered += Info.PriorityList.Num();
+	}
 
 	if (ForceNetUpdateReplicationActorList.Num() > 0)
 	{
 		Params.OutGatheredReplicationLists.AddReplicationActorList(ForceNetUpdateReplicationActorList);
 	}	
+
+	Info.NumGathered += NumGathered;
+	Info.NumGatheredWithoutLimiter += AllPlayerStates.Num();
 }
 
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
@@ -940,12 +1285,33 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplication
 	DebugInfo.Log(NodeName);
 	DebugInfo.PushIndent();	
 
+	DebugInfo.Log(FString::Printf(TEXT("Tracking %d player states in %d buckets, %d teams, %d recent combat pairs"), AllPlayerStates.Num(), ReplicationActorLists.Num(), TeamLists.Num(), RecentCombatTimes.Num()));
+
 	int32 i=0;
 	for (const FActorRepListRefView& List : ReplicationActorLists)
 	{
 		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
 	}
 
+	for (const auto& KVP : TeamLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Team[%d]"), KVP.Key), KVP.Value);
+	}
+
+	// Savings are counted in gathers: player states skipped compared to returning every player state every frame
+	for (const auto& KVP : ConnectionPriorityInfos)
+	{
+		const FConnectionPriorityInfo& Info = KVP.Value;
+		const int64 NumSkipped = Info.NumGatheredWithoutLimiter - Info.NumGathered;
+
+		DebugInfo.Log(FString::Printf(TEXT("%s: Team %d, %d combat partners, gathered %lld of %lld player states (%lld skipped)"),
+			*GetNameSafe(KVP.Key.ResolveObjectPtr()), Info.TeamId, Info.CombatList.Num(), Info.NumGathered, Info.NumGatheredWithoutLimiter, NumSkipped));
+
+		DebugInfo.PushIndent();
+		LogActorRepList(DebugInfo, TEXT("Combat"), Info.CombatList);
+		DebugInfo.PopIndent();
+	}
+
 	DebugInfo.PopIndent();
 }
 
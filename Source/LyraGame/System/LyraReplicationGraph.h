@@ -2,11 +2,14 @@
 
 #pragma once
 
+#include "GameFramework/GameplayMessageSubsystem.h"
 #include "ReplicationGraph.h"
 #include "LyraReplicationGraphTypes.h"
 #include "LyraReplicationGraph.generated.h"
 
 class AGameplayDebuggerCategoryReplicator;
+class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter;
+struct FLyraVerbMessage;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogLyraRepGraph, Display, All);
 
@@ -36,6 +39,9 @@ public:
 	UPROPERTY()
 	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
 
+	UPROPERTY()
+	TObjectPtr<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter> PlayerStateNode;
+
 	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
 
 #if WITH_GAMEPLAY_DEBUGGER
@@ -93,7 +99,12 @@ private:
 };
 
 /** 
-	This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. 
+	This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states (humans and bots) but only returns a subset
+	of them to the replication driver each frame. 
+
+	The tracked list is maintained incrementally as player states are added to and removed from the graph. On top of the rolling buckets, each connection also gets
+	the player states that matter most to it at a higher rate, a few per frame: enemies (including bots) it recently exchanged damage with, then team mates.
+
 	This is an optimization for large player connection counts, and not a requirement.
 */
 UCLASS()
@@ -103,8 +114,9 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 
 	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter();
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
+	virtual void NotifyResetAllNetworkActors() override;
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -112,11 +124,57 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 
 	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
 
+	virtual void BeginDestroy() override;
+
 	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
 private:
-	
+	struct FConnectionPriorityInfo
+	{
+		// Player states of enemies this connection recently damaged or was damaged by
+		FActorRepListRefView CombatList;
+
+		// Combat partners and team mates returned this frame, at most Lyra.RepGraph.PlayerState.PriorityActorsPerFrame of them
+		FActorRepListRefView PriorityList;
+
+		// Where the previous frame stopped in CombatList and in the team list
+		int32 CombatCursor = INDEX_NONE;
+		int32 TeamCursor = INDEX_NONE;
+
+		// The connection's player state and its team when the lists were last refreshed
+		FObjectKey ViewerPlayerState;
+		int32 TeamId = INDEX_NONE;
+
+		// Stats for the debug output (see LogNode)
+		int64 NumGathered = 0;
+		int64 NumGatheredWithoutLimiter = 0;
+	};
+
+	void RebuildBuckets();
+	void RegisterForDamageMessages();
+	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+
+	FConnectionPriorityInfo& RefreshConnectionPriority(const FConnectionGatherActorListParameters& Params);
+
+private:
+	// Every player state tracked by this node, kept up to date by NotifyAddNetworkActor / NotifyRemoveNetworkActor
+	FActorRepListRefView AllPlayerStates;
+
+	// Rolling buckets built from AllPlayerStates, only rebuilt when the tracked set changes
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
+	bool bBucketsDirty = true;
+
+	// Player states grouped by team, refreshed periodically since team changes are rare
+	TMap<int32, FActorRepListRefView> TeamLists;
+	int32 FramesUntilTeamRefresh = 0;
+
+	// Last time (world seconds) each pair of player states exchanged damage
+	TMap<TPair<FObjectKey, FObjectKey>, double> RecentCombatTimes;
+
+	TMap<FObjectKey, FConnectionPriorityInfo> ConnectionPriorityInfos;
+
+	FGameplayMessageListenerHandle DamageListenerHandle;
+	TWeakObjectPtr<UWorld> DamageListenerWorld;
 };
\ No newline at end of file
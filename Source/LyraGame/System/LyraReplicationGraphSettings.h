@@ -59,6 +59,11 @@ public:
 	UPROPERTY(EditAnywhere, Category = DynamicSpatialFrequency, meta = (ConsoleVariable = "Lyra.RepGraph.DynamicActorFrequencyBuckets"))
 	int32 DynamicActorFrequencyBuckets = 3;
 
+	// If true, dynamic spatialized actors replicate less often the further they are from each connection's viewer.
+	// This replaces the frequency buckets above for actors in the spatial grid.
+	UPROPERTY(EditAnywhere, Category = DynamicSpatialFrequency, meta = (ConsoleVariable = "Lyra.RepGraph.EnableDynamicSpatialFrequency"))
+	bool bEnableDynamicSpatialFrequency = true;
+
 	// Array of Custom Settings for Specific Classes 
 	UPROPERTY(config, EditAnywhere, Category = ReplicationGraph)
 	TArray<FRepGraphActorClassSettings> ClassSettings;
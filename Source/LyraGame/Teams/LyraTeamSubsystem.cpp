@@ -3,6 +3,8 @@
 #include "Teams/LyraTeamSubsystem.h"
 
 #include "AbilitySystemGlobals.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "LyraLogChannels.h"
@@ -17,6 +19,23 @@
 
 class FSubsystemCollectionBase;
 
+namespace LyraTeamSubsystem
+{
+	static bool bEnableTeamCache = true;
+	static FAutoConsoleVariableRef CVarEnableTeamCache(
+		TEXT("Lyra.Teams.EnableTeamCache"),
+		bEnableTeamCache,
+		TEXT("If true, FindTeamFromObject caches the resolved team per object until a team or possession change invalidates it."),
+		ECVF_Default);
+
+	static int32 MaxTeamCacheEntries = 4096;
+	static FAutoConsoleVariableRef CVarMaxTeamCacheEntries(
+		TEXT("Lyra.Teams.MaxTeamCacheEntries"),
+		MaxTeamCacheEntries,
+		TEXT("Number of cached object->team entries after which the cache is flushed (protects against churn from short lived actors like projectiles)."),
+		ECVF_Default);
+};
+
 //////////////////////////////////////////////////////////////////////
 // FLyraTeamTrackingInfo
 
@@ -85,9 +104,27 @@ void ULyraTeamSubsystem::Deinitialize()
 {
 	UCheatManager::UnregisterFromOnCheatManagerCreated(CheatManagerRegistrationHandle);
 
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+
+	InvalidateTeamCache();
+
 	Super::Deinitialize();
 }
 
+void ULyraTeamSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Possession changes alter which player state (and therefore team) a pawn resolves to
+	if (UGameInstance* GameInstance = InWorld.GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.AddUniqueDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
 bool ULyraTeamSubsystem::RegisterTeamInfo(ALyraTeamInfoBase* TeamInfo)
 {
 	if (!ensure(TeamInfo))
@@ -152,6 +189,53 @@ bool ULyraTeamSubsystem::ChangeTeamForActor(AActor* ActorToChange, int32 NewTeam
 
 int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 {
+	if ((TestObject == nullptr) || !LyraTeamSubsystem::bEnableTeamCache)
+	{
+		bool bCacheable = false;
+		return FindTeamFromObject_Uncached(TestObject, bCacheable);
+	}
+
+	const FObjectKey Key(TestObject);
+	const bool bIsInGameThread = IsInGameThread();
+
+	// Writes only ever happen on the game thread, so it can read without taking the lock
+	if (bIsInGameThread)
+	{
+		if (const int32* CachedTeamId = TeamCache.Find(Key))
+		{
+			return *CachedTeamId;
+		}
+	}
+	else
+	{
+		// Resolving walks UObjects (instigators, player states), which isn't safe here, so a miss reports no team
+		FReadScopeLock ReadLock(TeamCacheLock);
+		const int32* CachedTeamId = TeamCache.Find(Key);
+		return CachedTeamId ? *CachedTeamId : INDEX_NONE;
+	}
+
+	bool bCacheable = false;
+	const int32 TeamId = FindTeamFromObject_Uncached(TestObject, bCacheable);
+
+	// Only positive results are cached, as INDEX_NONE is often transient (e.g., a player state that hasn't replicated yet)
+	if (bCacheable && (TeamId != INDEX_NONE))
+	{
+		FWriteScopeLock WriteLock(TeamCacheLock);
+		if (TeamCache.Num() >= LyraTeamSubsystem::MaxTeamCacheEntries)
+		{
+			TeamCache.Reset();
+		}
+		TeamCache.Add(Key, TeamId);
+	}
+
+	return TeamId;
+}
+
+int32 ULyraTeamSubsystem::FindTeamFromObject_Uncached(const UObject* TestObject, bool& bOutCacheable) const
+{
+	// Team changes and possession changes invalidate the cache, so results from the object itself (or its controller / player state) can be kept
+	bOutCacheable = true;
+
 	// See if it's directly a team agent
 	if (const ILyraTeamAgentInterface* ObjectWithTeamInterface = Cast<ILyraTeamAgentInterface>(TestObject))
 	{
@@ -160,9 +244,10 @@ int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
 
 	if (const AActor* TestActor = Cast<const AActor>(TestObject))
 	{
-		// See if the instigator is a team actor
+		// See if the instigator is a team actor (equipment, projectiles, dropped weapons); the instigator can change, so don't cache this
 		if (const ILyraTeamAgentInterface* InstigatorWithTeamInterface = Cast<ILyraTeamAgentInterface>(TestActor->GetInstigator()))
 		{
+			bOutCacheable = false;
 			return GenericTeamIdToInteger(InstigatorWithTeamInterface->GetGenericTeamId());
 		}
 
@@ -397,3 +482,19 @@ FOnLyraTeamDisplayAssetChangedDelegate& ULyraTeamSubsystem::GetTeamDisplayAssetC
 	return TeamMap.FindOrAdd(TeamId).OnTeamDisplayAssetChanged;
 }
 
+void ULyraTeamSubsystem::InvalidateTeamCache()
+{
+	// Team changes are rare compared to lookups, and derived entries (projectiles, instigated actors) can depend on the
+	// changed agent, so the whole cache is dropped instead of trying to track dependencies
+	FWriteScopeLock WriteLock(TeamCacheLock);
+	TeamCache.Reset();
+}
+
+void ULyraTeamSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* NewController)
+{
+	if ((Pawn != nullptr) && (Pawn->GetWorld() == GetWorld()))
+	{
+		InvalidateTeamCache();
+	}
+}
+
@@ -2,15 +2,19 @@
 
 #pragma once
 
+#include "Misc/ScopeRWLock.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "LyraTeamSubsystem.generated.h"
 
 class AActor;
+class AController;
 class ALyraPlayerState;
 class ALyraTeamInfoBase;
 class ALyraTeamPrivateInfo;
 class ALyraTeamPublicInfo;
+class APawn;
 class FSubsystemCollectionBase;
 class ULyraTeamDisplayAsset;
 struct FFrame;
@@ -69,6 +73,10 @@ public:
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	//~UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
 	// Tries to registers a new team
 	bool RegisterTeamInfo(ALyraTeamInfoBase* TeamInfo);
 
@@ -81,6 +89,8 @@ public:
 	bool ChangeTeamForActor(AActor* ActorToChange, int32 NewTeamId);
 
 	// Returns the team this object belongs to, or INDEX_NONE if it is not part of a team
+	// Teams of team agents, pawns, controllers and player states are cached per object, so this is cheap to call repeatedly.
+	// Off the game thread only cached results are returned (INDEX_NONE on a miss), resolving a team walks UObjects.
 	int32 FindTeamFromObject(const UObject* TestObject) const;
 
 	// Returns the associated player state for this actor, or INDEX_NONE if it is not associated with a player
@@ -140,9 +150,24 @@ public:
 	// Register for a team display asset notification for the specified team ID
 	FOnLyraTeamDisplayAssetChangedDelegate& GetTeamDisplayAssetChangedDelegate(int32 TeamId);
 
+	// Drops all cached object->team associations (called when any team agent changes team or a pawn changes controller)
+	void InvalidateTeamCache();
+
+private:
+	// Resolves the team of an object without consulting the cache (interface casts, instigator and player state walking).
+	// bOutCacheable is false when the team came from another object (the instigator), which can change without us noticing.
+	int32 FindTeamFromObject_Uncached(const UObject* TestObject, bool& bOutCacheable) const;
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* NewController);
+
 private:
 	UPROPERTY()
 	TMap<int32, FLyraTeamTrackingInfo> TeamMap;
 
 	FDelegateHandle CheatManagerRegistrationHandle;
+
+	// Resolved team IDs keyed by the queried object; only written on the game thread, read from any thread under TeamCacheLock
+	mutable TMap<FObjectKey, int32> TeamCache;
+	mutable FRWLock TeamCacheLock;
 };
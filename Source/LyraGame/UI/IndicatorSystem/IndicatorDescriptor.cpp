@@ -102,6 +102,79 @@ bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescript
 	return false;
 }
 
+bool FIndicatorProjection::GetWorldProjectionPoint(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldPoint)
+{
+	USceneComponent* Component = IndicatorDescriptor.GetSceneComponent();
+	if (Component == nullptr)
+	{
+		return false;
+	}
+
+	switch (IndicatorDescriptor.GetProjectionMode())
+	{
+		case EActorCanvasProjectionMode::ComponentPoint:
+		{
+			const FVector WorldLocation = (IndicatorDescriptor.GetComponentSocketName() != NAME_None) ? Component->GetSocketLocation(IndicatorDescriptor.GetComponentSocketName()) : Component->GetComponentLocation();
+			OutWorldPoint = WorldLocation + IndicatorDescriptor.GetWorldPositionOffset();
+			return true;
+		}
+		case EActorCanvasProjectionMode::ActorBoundingBox:
+		case EActorCanvasProjectionMode::ComponentBoundingBox:
+		{
+			const FBox IndicatorBox = (IndicatorDescriptor.GetProjectionMode() == EActorCanvasProjectionMode::ActorBoundingBox) ? Component->GetOwner()->GetComponentsBoundingBox() : Component->Bounds.GetBox();
+			OutWorldPoint = IndicatorBox.GetCenter() + (IndicatorBox.GetSize() * (IndicatorDescriptor.GetBoundingBoxAnchor() - FVector(0.5)));
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+void FIndicatorProjection::ProjectPoints(const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, TConstArrayView<FVector> WorldPoints, TArrayView<FVector> OutScreenPositionsWithDepth, TArrayView<bool> OutInFrontOfCamera)
+{
+	check(WorldPoints.Num() == OutScreenPositionsWithDepth.Num());
+	check(WorldPoints.Num() == OutInFrontOfCamera.Num());
+
+	// ULocalPlayer::GetPixelPoint rebuilds this matrix for every point, do it once for the whole batch instead
+	const FMatrix ViewProjectionMatrix = InProjectionData.ComputeViewProjectionMatrix();
+	const VectorRegister4Double Row0 = VectorLoad(&ViewProjectionMatrix.M[0][0]);
+	const VectorRegister4Double Row1 = VectorLoad(&ViewProjectionMatrix.M[1][0]);
+	const VectorRegister4Double Row2 = VectorLoad(&ViewProjectionMatrix.M[2][0]);
+	const VectorRegister4Double Row3 = VectorLoad(&ViewProjectionMatrix.M[3][0]);
+
+	const FIntRect ViewRect = InProjectionData.GetConstrainedViewRect();
+	const double ViewWidth = (double)ViewRect.Width();
+	const double ViewHeight = (double)ViewRect.Height();
+	const FVector ViewOrigin = InProjectionData.ViewOrigin;
+
+	for (int32 Index = 0; Index < WorldPoints.Num(); ++Index)
+	{
+		const FVector& WorldPoint = WorldPoints[Index];
+
+		// Row vector * matrix: X * Row0 + Y * Row1 + Z * Row2 + Row3
+		VectorRegister4Double ClipPosition = VectorMultiplyAdd(VectorSetFloat1(WorldPoint.Z), Row2, Row3);
+		ClipPosition = VectorMultiplyAdd(VectorSetFloat1(WorldPoint.Y), Row1, ClipPosition);
+		ClipPosition = VectorMultiplyAdd(VectorSetFloat1(WorldPoint.X), Row0, ClipPosition);
+
+		FVector4 Result;
+		VectorStore(ClipPosition, &Result.X);
+
+		OutInFrontOfCamera[Index] = (Result.W >= 0.0);
+
+		const double W = (Result.W == 0.0) ? 1.0 : FMath::Abs(Result.W);
+		const double NormalizedX = ((Result.X / W) * 0.5) + 0.5;
+		const double NormalizedY = 1.0 - ((Result.Y / W) * 0.5) - 0.5;
+
+		const double PixelX = (NormalizedX * ViewWidth) + ViewRect.Min.X;
+		const double PixelY = (NormalizedY * ViewHeight) + ViewRect.Min.Y;
+
+		OutScreenPositionsWithDepth[Index] = FVector(
+			(PixelX / ViewWidth) * ScreenSize.X,
+			(PixelY / ViewHeight) * ScreenSize.Y,
+			FVector::Dist(ViewOrigin, WorldPoint));
+	}
+}
+
 void UIndicatorDescriptor::SetIndicatorManagerComponent(ULyraIndicatorManagerComponent* InManager)
 {
 	// Make sure nobody has set this.
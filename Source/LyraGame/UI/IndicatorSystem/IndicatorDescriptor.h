@@ -17,6 +17,18 @@ struct FSceneViewProjectionData;
 struct FIndicatorProjection
 {
 	bool Project(const UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, FVector& ScreenPositionWithDepth);
+
+	/**
+	 * Gets the single world space point an indicator projects to, for the projection modes that only need one (everything but the screen bounding box modes).
+	 * Returns false if the indicator has to go through Project instead.
+	 */
+	static bool GetWorldProjectionPoint(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldPoint);
+
+	/**
+	 * Projects a batch of world points with a single view projection matrix, matching the results of ULocalPlayer::GetPixelPoint.
+	 * OutScreenPositionsWithDepth receives the pixel position in X/Y and the distance to the view origin in Z.
+	 */
+	static void ProjectPoints(const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, TConstArrayView<FVector> WorldPoints, TArrayView<FVector> OutScreenPositionsWithDepth, TArrayView<bool> OutInFrontOfCamera);
 };
 
 UENUM(BlueprintType)
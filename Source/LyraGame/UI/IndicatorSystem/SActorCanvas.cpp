@@ -13,6 +13,23 @@
 
 class FSlateRect;
 
+namespace ActorCanvasCVars
+{
+	static bool EnableBatchedProjection = true;
+	static FAutoConsoleVariableRef CVarEnableBatchedProjection(
+		TEXT("Lyra.Indicators.EnableBatchedProjection"),
+		EnableBatchedProjection,
+		TEXT("Projects point and bounding box indicators with a single batched pass per view instead of one at a time"),
+		ECVF_Default);
+
+	static float OffscreenCullMargin = 256.0f;
+	static FAutoConsoleVariableRef CVarOffscreenCullMargin(
+		TEXT("Lyra.Indicators.OffscreenCullMargin"),
+		OffscreenCullMargin,
+		TEXT("Indicators that are not clamped to the screen get collapsed once they are this many pixels outside of the canvas"),
+		ECVF_Default);
+}
+
 namespace EArrowDirection
 {
 	enum Type
@@ -182,6 +199,7 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 			{
 				OnIndicatorAdded(Indicator);
 			}
+			StartAsyncLoading();
 		}
 		else
 		{
@@ -202,68 +220,89 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 
 			bool IndicatorsChanged = false;
 
-			for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
+			BatchedSlotIndices.Reset();
+			BatchedWorldPoints.Reset();
+
+			// Gather: drop dead indicators, update visibility and collect the world points that can be projected as a batch
 			{
-				SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
-				UIndicatorDescriptor* Indicator = CurChild.Indicator;
+				QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateCanvas_Gather);
 
-				// If the slot content is invalid and we have permission to remove it
-				if (Indicator->CanAutomaticallyRemove())
+				for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 				{
-					IndicatorsChanged = true;
+					SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
+					UIndicatorDescriptor* Indicator = CurChild.Indicator;
 
-					RemoveIndicatorForEntry(Indicator);
-					// Decrement the current index to account for the removal 
-					--ChildIndex;
-					continue;
-				}
+					// If the slot content is invalid and we have permission to remove it
+					if (Indicator->CanAutomaticallyRemove())
+					{
+						IndicatorsChanged = true;
 
-				CurChild.SetIsIndicatorVisible(Indicator->GetIsVisible());
+						RemoveIndicatorForEntry(Indicator);
+						// Decrement the current index to account for the removal 
+						--ChildIndex;
+						continue;
+					}
 
-				if (!CurChild.GetIsIndicatorVisible())
-				{
-					IndicatorsChanged |= CurChild.bIsDirty();
-					CurChild.ClearDirtyFlag();
-					continue;
-				}
+					CurChild.SetIsIndicatorVisible(Indicator->GetIsVisible());
 
-				// If the indicator changed clamp status between updates, alert the indicator and mark the indicators as changed
-				if (CurChild.WasIndicatorClampedStatusChanged())
-				{
-					//Indicator->OnIndicatorClampedStatusChanged(CurChild.WasIndicatorClamped());
-					CurChild.ClearIndicatorClampedStatusChangedFlag();
-					IndicatorsChanged = true;
-				}
+					if (!CurChild.GetIsIndicatorVisible())
+					{
+						IndicatorsChanged |= CurChild.bIsDirty();
+						CurChild.ClearDirtyFlag();
+						continue;
+					}
 
-				FVector ScreenPositionWithDepth;
+					// If the indicator changed clamp status between updates, alert the indicator and mark the indicators as changed
+					if (CurChild.WasIndicatorClampedStatusChanged())
+					{
+						//Indicator->OnIndicatorClampedStatusChanged(CurChild.WasIndicatorClamped());
+						CurChild.ClearIndicatorClampedStatusChangedFlag();
+						IndicatorsChanged = true;
+					}
+
+					FVector WorldPoint;
+					if (ActorCanvasCVars::EnableBatchedProjection && FIndicatorProjection::GetWorldProjectionPoint(*Indicator, OUT WorldPoint))
+					{
+						BatchedSlotIndices.Add(ChildIndex);
+						BatchedWorldPoints.Add(WorldPoint);
+						continue;
+					}
 
-				FIndicatorProjection Projector;
-				const bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
+					// Screen bounding box modes need the whole box projected, so they stay on the per indicator path
+					FVector ScreenPositionWithDepth;
 
-				if (!Success)
-				{
-					CurChild.SetHasValidScreenPosition(false);
-					CurChild.SetInFrontOfCamera(false);
+					FIndicatorProjection Projector;
+					const bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
 
-					IndicatorsChanged |= CurChild.bIsDirty();
-					CurChild.ClearDirtyFlag();
-					continue;
+					IndicatorsChanged |= ApplyProjectionToSlot(CurChild, Success, ScreenPositionWithDepth, PaintGeometry.Size);
 				}
+			}
+
+			// Project: run every gathered point through the view projection matrix in one go
+			{
+				QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateCanvas_Project);
+
+				BatchedScreenPositions.SetNumUninitialized(BatchedWorldPoints.Num(), EAllowShrinking::No);
+				BatchedInFrontOfCamera.SetNumUninitialized(BatchedWorldPoints.Num(), EAllowShrinking::No);
+
+				FIndicatorProjection::ProjectPoints(ProjectionData, PaintGeometry.Size, BatchedWorldPoints, BatchedScreenPositions, BatchedInFrontOfCamera);
+			}
 
-				CurChild.SetInFrontOfCamera(Success);
-				CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || Indicator->GetClampToScreen());
+			// Apply: only now touch the slots, and only the ones whose state actually changed will dirty the canvas
+			{
+				QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateCanvas_Apply);
 
-				if (CurChild.HasValidScreenPosition())
+				for (int32 BatchIndex = 0; BatchIndex < BatchedSlotIndices.Num(); ++BatchIndex)
 				{
-					// Only dirty the screen position if we can actually show this indicator.
-					CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
-					CurChild.SetDepth(ScreenPositionWithDepth.X);
-				}
+					SActorCanvas::FSlot& CurChild = CanvasChildren[BatchedSlotIndices[BatchIndex]];
 
-				CurChild.SetPriority(Indicator->GetPriority());
+					FVector ScreenPositionWithDepth = BatchedScreenPositions[BatchIndex];
+					const FVector2D& ScreenSpaceOffset = CurChild.Indicator->GetScreenSpaceOffset();
+					ScreenPositionWithDepth.X += ScreenSpaceOffset.X;
+					ScreenPositionWithDepth.Y += ScreenSpaceOffset.Y;
 
-				IndicatorsChanged |= CurChild.bIsDirty();
-				CurChild.ClearDirtyFlag();
+					IndicatorsChanged |= ApplyProjectionToSlot(CurChild, BatchedInFrontOfCamera[BatchIndex], ScreenPositionWithDepth, PaintGeometry.Size);
+				}
 			}
 
 			if (IndicatorsChanged)
@@ -292,6 +331,49 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 	}
 }
 
+bool SActorCanvas::ApplyProjectionToSlot(FSlot& CurChild, bool bSuccess, const FVector& ScreenPositionWithDepth, const FVector2f& ScreenSize)
+{
+	UIndicatorDescriptor* Indicator = CurChild.Indicator;
+
+	if (!bSuccess)
+	{
+		CurChild.SetHasValidScreenPosition(false);
+		CurChild.SetInFrontOfCamera(false);
+	}
+	else
+	{
+		CurChild.SetInFrontOfCamera(bSuccess);
+
+		bool bValidScreenPosition = CurChild.GetInFrontOfCamera() || Indicator->GetClampToScreen();
+
+		// Indicators that are not clamped and land well outside the canvas would only be clipped by Slate, so collapse them instead
+		if (bValidScreenPosition && !Indicator->GetClampToScreen())
+		{
+			const double Margin = ActorCanvasCVars::OffscreenCullMargin;
+			if (ScreenPositionWithDepth.X < -Margin || ScreenPositionWithDepth.Y < -Margin ||
+				ScreenPositionWithDepth.X > ScreenSize.X + Margin || ScreenPositionWithDepth.Y > ScreenSize.Y + Margin)
+			{
+				bValidScreenPosition = false;
+			}
+		}
+
+		CurChild.SetHasValidScreenPosition(bValidScreenPosition);
+
+		if (CurChild.HasValidScreenPosition())
+		{
+			// Only dirty the screen position if we can actually show this indicator.
+			CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
+			CurChild.SetDepth(ScreenPositionWithDepth.X);
+		}
+
+		CurChild.SetPriority(Indicator->GetPriority());
+	}
+
+	const bool bChanged = CurChild.bIsDirty();
+	CurChild.ClearDirtyFlag();
+	return bChanged;
+}
+
 void SActorCanvas::SetShowAnyIndicators(bool bIndicators)
 {
 	if (bShowAnyIndicators != bIndicators)
@@ -597,7 +679,10 @@ void SActorCanvas::AddIndicatorForEntry(UIndicatorDescriptor* Indicator)
 				}
 			}
 		});
-		StartAsyncLoading();
+
+		// Don't start here. Indicators tend to arrive in bursts (e.g. a nameplate for every pawn that spawns
+		// on the same frame), and leaving the start to the mixin's next-tick kickoff lets all of their widget
+		// classes go out as one streamable request.
 	}
 }
 
@@ -224,6 +224,9 @@ private:
 
 	void UpdateActiveTimer();
 
+	/** Pushes a projection result into a slot, returns true if the slot changed */
+	bool ApplyProjectionToSlot(FSlot& CurChild, bool bSuccess, const FVector& ScreenPositionWithDepth, const FVector2f& ScreenSize);
+
 private:
 	TArray<TObjectPtr<UIndicatorDescriptor>> AllIndicators;
 	TArray<TObjectPtr<UIndicatorDescriptor>> InactiveIndicators;
@@ -251,4 +254,10 @@ private:
 	mutable TOptional<FGeometry> OptionalPaintGeometry;
 
 	TSharedPtr<FActiveTimerHandle> TickHandle;
+
+	/** Scratch arrays for the batched projection in UpdateCanvas, kept around to avoid reallocating every frame */
+	TArray<int32> BatchedSlotIndices;
+	TArray<FVector> BatchedWorldPoints;
+	TArray<FVector> BatchedScreenPositions;
+	TArray<bool> BatchedInFrontOfCamera;
 };
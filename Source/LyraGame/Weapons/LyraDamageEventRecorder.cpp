@@ -0,0 +1,418 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraDamageEventRecorder.h"
+
+#include "AbilitySystem/LyraGameplayEffectContext.h"
+#include "Engine/World.h"
+#include "GameplayEffect.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "LyraLogChannels.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraDamageEventRecorder)
+
+namespace LyraConsoleVariables
+{
+	static bool bDamageLogEnabled = false;
+	static FAutoConsoleVariableRef CVarDamageLogEnabled(
+		TEXT("Lyra.DamageLog.Enabled"),
+		bDamageLogEnabled,
+		TEXT("If true, servers record every damage and elimination event to Saved/DamageLogs (takes effect for worlds created afterwards)"),
+		ECVF_Default);
+
+	static int32 DamageLogRingCapacity = 4096;
+	static FAutoConsoleVariableRef CVarDamageLogRingCapacity(
+		TEXT("Lyra.DamageLog.RingCapacity"),
+		DamageLogRingCapacity,
+		TEXT("Number of damage events each producing thread can buffer before the writer drains them, extra events are dropped"),
+		ECVF_Default);
+
+	static float DamageLogFlushInterval = 0.5f;
+	static FAutoConsoleVariableRef CVarDamageLogFlushInterval(
+		TEXT("Lyra.DamageLog.FlushInterval"),
+		DamageLogFlushInterval,
+		TEXT("How often the damage log writer drains the ring buffers and flushes to disk (in seconds)"),
+		ECVF_Default);
+}
+
+namespace LyraDamageLog
+{
+	static const uint32 FileMagic = 0x474D444C; // 'LDMG'
+	static const uint32 FileVersion = 1;
+
+	// Every record in the file starts with one of these
+	enum class ERecordType : uint8
+	{
+		Name = 0,
+		Event = 1,
+	};
+
+	static std::atomic<uint32> NextRecorderId = 1;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraDamageEventLog
+
+FArchive& operator<<(FArchive& Ar, FLyraDamageEventLogEntry& Entry)
+{
+	Ar << Entry.Time;
+	Ar << Entry.InstigatorNameId;
+	Ar << Entry.TargetNameId;
+	Ar << Entry.WeaponNameId;
+	Ar << Entry.HitZoneNameId;
+	Ar << Entry.Damage;
+	Ar << Entry.Distance;
+	Ar << Entry.Flags;
+	return Ar;
+}
+
+FString FLyraDamageEventLog::GetLogDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("DamageLogs");
+}
+
+bool FLyraDamageEventLog::LoadFromFile(const FString& Filename)
+{
+	Names.Reset();
+	Events.Reset();
+	Names.Add(FString());
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	*Reader << Magic;
+	*Reader << Version;
+	if ((Magic != LyraDamageLog::FileMagic) || (Version != LyraDamageLog::FileVersion) || Reader->IsError())
+	{
+		UE_LOG(LogLyra, Error, TEXT("%s is not a version %u damage log"), *Filename, LyraDamageLog::FileVersion);
+		return false;
+	}
+
+	while (!Reader->AtEnd())
+	{
+		uint8 RecordType = 0;
+		*Reader << RecordType;
+
+		if (RecordType == (uint8)LyraDamageLog::ERecordType::Name)
+		{
+			uint32 NameId = 0;
+			FString Name;
+			*Reader << NameId;
+			*Reader << Name;
+			if (Reader->IsError())
+			{
+				break;
+			}
+			if (NameId >= (uint32)Names.Num())
+			{
+				Names.SetNum(NameId + 1);
+			}
+			Names[NameId] = MoveTemp(Name);
+		}
+		else if (RecordType == (uint8)LyraDamageLog::ERecordType::Event)
+		{
+			FLyraDamageEventLogEntry Entry;
+			*Reader << Entry;
+			if (Reader->IsError())
+			{
+				break;
+			}
+			Events.Add(Entry);
+		}
+		else
+		{
+			UE_LOG(LogLyra, Warning, TEXT("Unknown record type %u in damage log %s, ignoring the rest of the file"), RecordType, *Filename);
+			break;
+		}
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraDamageEventRecorder::FWriter
+
+class ULyraDamageEventRecorder::FWriter : public FRunnable
+{
+public:
+	FWriter(ULyraDamageEventRecorder& InRecorder, TUniquePtr<FArchive>&& InArchive)
+		: Recorder(InRecorder)
+		, Archive(MoveTemp(InArchive))
+		, WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+	{
+	}
+
+	virtual ~FWriter() override
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	//~FRunnable interface
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested)
+		{
+			WakeEvent->Wait(FTimespan::FromSeconds(FMath::Max(LyraConsoleVariables::DamageLogFlushInterval, 0.01f)));
+			DrainRings();
+		}
+
+		// Pick up anything recorded while stopping
+		DrainRings();
+		Archive->Close();
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested = true;
+		WakeEvent->Trigger();
+	}
+	//~End of FRunnable interface
+
+	int64 GetNumWritten() const { return NumWritten; }
+	int64 GetNumDropped() const { return NumDropped; }
+
+private:
+	uint32 GetNameId(FName Name)
+	{
+		if (Name.IsNone())
+		{
+			return 0;
+		}
+
+		if (const uint32* ExistingId = NameIds.Find(Name))
+		{
+			return *ExistingId;
+		}
+
+		// Names are written the first time they're used, ahead of the event that references them
+		uint32 NewId = NameIds.Num() + 1;
+		NameIds.Add(Name, NewId);
+
+		uint8 RecordType = (uint8)LyraDamageLog::ERecordType::Name;
+		FString NameString = Name.ToString();
+		*Archive << RecordType;
+		*Archive << NewId;
+		*Archive << NameString;
+
+		return NewId;
+	}
+
+	void DrainRings()
+	{
+		bool bWroteAnything = false;
+
+		FScopeLock RingsScopeLock(&Recorder.RingsLock);
+		for (const TUniquePtr<FProducerRing>& Ring : Recorder.Rings)
+		{
+			FPendingEvent Event;
+			while (Ring->Events.Dequeue(Event))
+			{
+				FLyraDamageEventLogEntry Entry;
+				Entry.Time = Event.Time;
+				Entry.InstigatorNameId = GetNameId(Event.Instigator);
+				Entry.TargetNameId = GetNameId(Event.Target);
+				Entry.WeaponNameId = GetNameId(Event.Weapon);
+				Entry.HitZoneNameId = GetNameId(Event.HitZone);
+				Entry.Damage = Event.Damage;
+				Entry.Distance = Event.Distance;
+				Entry.Flags = Event.Flags;
+
+				uint8 RecordType = (uint8)LyraDamageLog::ERecordType::Event;
+				*Archive << RecordType;
+				*Archive << Entry;
+
+				++NumWritten;
+				bWroteAnything = true;
+			}
+
+			NumDropped += Ring->NumDropped.exchange(0, std::memory_order_relaxed);
+		}
+
+		if (bWroteAnything)
+		{
+			Archive->Flush();
+		}
+	}
+
+	ULyraDamageEventRecorder& Recorder;
+	TUniquePtr<FArchive> Archive;
+	FEvent* WakeEvent;
+	std::atomic<bool> bStopRequested = false;
+
+	// Only touched by the writer thread
+	TMap<FName, uint32> NameIds;
+	int64 NumWritten = 0;
+	int64 NumDropped = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+// ULyraDamageEventRecorder
+
+ULyraDamageEventRecorder::ULyraDamageEventRecorder()
+{
+}
+
+ULyraDamageEventRecorder::~ULyraDamageEventRecorder()
+{
+	// Defined here so the writer is a complete type, it's normally stopped in Deinitialize already
+	StopWriter();
+}
+
+bool ULyraDamageEventRecorder::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!LyraConsoleVariables::bDamageLogEnabled || !Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Damage is only applied with authority
+	UWorld* World = Outer->GetWorld();
+	return (World != nullptr) && (World->GetNetMode() != NM_Client);
+}
+
+bool ULyraDamageEventRecorder::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void ULyraDamageEventRecorder::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const FString Filename = FLyraDamageEventLog::GetLogDirectory() / FString::Printf(TEXT("DamageLog-%s-%s.ldmg"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+	TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogLyra, Error, TEXT("Could not create damage log %s, damage events will not be recorded"), *Filename);
+		return;
+	}
+
+	uint32 Magic = LyraDamageLog::FileMagic;
+	uint32 Version = LyraDamageLog::FileVersion;
+	*Archive << Magic;
+	*Archive << Version;
+
+	RecorderId = LyraDamageLog::NextRecorderId.fetch_add(1, std::memory_order_relaxed);
+	StartTime = FPlatformTime::Seconds();
+
+	Writer = MakeUnique<FWriter>(*this, MoveTemp(Archive));
+	WriterThread = FRunnableThread::Create(Writer.Get(), TEXT("LyraDamageLogWriter"), 0, TPri_BelowNormal);
+
+	UE_LOG(LogLyra, Log, TEXT("Recording damage events to %s"), *Filename);
+}
+
+void ULyraDamageEventRecorder::Deinitialize()
+{
+	StopWriter();
+
+	Super::Deinitialize();
+}
+
+void ULyraDamageEventRecorder::StopWriter()
+{
+	if (WriterThread != nullptr)
+	{
+		// Kill calls Stop on the runnable and waits for the final drain
+		WriterThread->Kill(/*bShouldWait=*/ true);
+		delete WriterThread;
+		WriterThread = nullptr;
+
+		UE_LOG(LogLyra, Log, TEXT("Damage log closed: %lld events written, %lld dropped"), Writer->GetNumWritten(), Writer->GetNumDropped());
+	}
+
+	Writer.Reset();
+	RecorderId = 0;
+}
+
+ULyraDamageEventRecorder::FProducerRing& ULyraDamageEventRecorder::GetRingForCurrentThread()
+{
+	// Rings are owned by the recorder, each thread remembers which ring it was given by which recorder
+	static thread_local TMap<uint32, FProducerRing*, TInlineSetAllocator<2>> ThreadRings;
+
+	if (FProducerRing** ExistingRing = ThreadRings.Find(RecorderId))
+	{
+		return **ExistingRing;
+	}
+
+	FProducerRing* NewRing = new FProducerRing(FMath::Max(LyraConsoleVariables::DamageLogRingCapacity, 64));
+	{
+		FScopeLock RingsScopeLock(&RingsLock);
+		Rings.Emplace(NewRing);
+	}
+	ThreadRings.Add(RecorderId, NewRing);
+
+	return *NewRing;
+}
+
+void ULyraDamageEventRecorder::Record(FPendingEvent&& Event)
+{
+	FProducerRing& Ring = GetRingForCurrentThread();
+	if (!Ring.Events.Enqueue(MoveTemp(Event)))
+	{
+		Ring.NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void ULyraDamageEventRecorder::RecordDamage(UWorld* World, const FGameplayEffectSpec& DamageEffectSpec, const AActor* Target, float Damage, bool bEliminatedTarget)
+{
+	ULyraDamageEventRecorder* Recorder = World ? World->GetSubsystem<ULyraDamageEventRecorder>() : nullptr;
+	if ((Recorder == nullptr) || (Recorder->WriterThread == nullptr))
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraDamageEventRecorder_RecordDamage);
+
+	const FGameplayEffectContextHandle& EffectContext = DamageEffectSpec.GetEffectContext();
+	const AActor* Instigator = EffectContext.GetOriginalInstigator();
+	const FHitResult* HitResult = EffectContext.GetHitResult();
+
+	FPendingEvent Event;
+	Event.Time = FPlatformTime::Seconds() - Recorder->StartTime;
+	Event.Instigator = Instigator ? Instigator->GetFName() : NAME_None;
+	Event.Target = Target ? Target->GetFName() : NAME_None;
+	Event.Damage = Damage;
+	Event.Flags = bEliminatedTarget ? ELyraDamageEventFlags::Elimination : ELyraDamageEventFlags::None;
+
+	// Weapons are identified by the class of their ability source, anything else (fall damage, etc...) by the effect
+	const FLyraGameplayEffectContext* TypedContext = FLyraGameplayEffectContext::ExtractEffectContext(EffectContext);
+	const UObject* AbilitySourceObject = (TypedContext && TypedContext->GetAbilitySource()) ? Cast<const UObject>(TypedContext->GetAbilitySource()) : nullptr;
+	if (AbilitySourceObject)
+	{
+		Event.Weapon = AbilitySourceObject->GetClass()->GetFName();
+	}
+	else if (DamageEffectSpec.Def)
+	{
+		Event.Weapon = DamageEffectSpec.Def->GetClass()->GetFName();
+	}
+
+	// Hit zones are the bone that was hit, which is what weak spot physical materials are assigned to
+	FVector ImpactLocation = Target ? Target->GetActorLocation() : FVector::ZeroVector;
+	if (HitResult)
+	{
+		Event.HitZone = HitResult->BoneName;
+		ImpactLocation = HitResult->ImpactPoint;
+	}
+
+	if (EffectContext.HasOrigin())
+	{
+		Event.Distance = FVector::Dist(EffectContext.GetOrigin(), ImpactLocation);
+	}
+	else if (Instigator)
+	{
+		Event.Distance = FVector::Dist(Instigator->GetActorLocation(), ImpactLocation);
+	}
+
+	Recorder->Record(MoveTemp(Event));
+}
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/CircularQueue.h"
+#include "HAL/CriticalSection.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraDamageEventRecorder.generated.h"
+
+class AActor;
+class FArchive;
+class FEvent;
+class FRunnableThread;
+struct FGameplayEffectSpec;
+
+/** Flags stored with each damage event */
+enum class ELyraDamageEventFlags : uint8
+{
+	None = 0,
+
+	// This damage brought the target's health to zero
+	Elimination = 1 << 0,
+};
+ENUM_CLASS_FLAGS(ELyraDamageEventFlags);
+
+/** A damage event as written to a damage log, names are indices into the log's name table */
+struct FLyraDamageEventLogEntry
+{
+	// Seconds since the recorder started
+	double Time = 0.0;
+
+	uint32 InstigatorNameId = 0;
+	uint32 TargetNameId = 0;
+	uint32 WeaponNameId = 0;
+	uint32 HitZoneNameId = 0;
+
+	float Damage = 0.0f;
+	float Distance = 0.0f;
+	ELyraDamageEventFlags Flags = ELyraDamageEventFlags::None;
+
+	bool IsElimination() const { return EnumHasAnyFlags(Flags, ELyraDamageEventFlags::Elimination); }
+
+	friend FArchive& operator<<(FArchive& Ar, FLyraDamageEventLogEntry& Entry);
+};
+
+/** The contents of a damage log file */
+struct LYRAGAME_API FLyraDamageEventLog
+{
+	// Name table, the entry at index 0 is always empty
+	TArray<FString> Names;
+	TArray<FLyraDamageEventLogEntry> Events;
+
+	const FString& GetName(uint32 NameId) const { return Names.IsValidIndex(NameId) ? Names[NameId] : Names[0]; }
+
+	/** Reads a log written by ULyraDamageEventRecorder, returns false if the file is missing or isn't a damage log. Truncated logs load up to the last complete record. */
+	bool LoadFromFile(const FString& Filename);
+
+	/** Directory that recorded logs are written to */
+	static FString GetLogDirectory();
+};
+
+/**
+ * ULyraDamageEventRecorder
+ *
+ *	Server side recorder for every damage and elimination event, meant to be left on in production to gather
+ *	balancing data (see ULyraDamageLogAnalyzerCommandlet). Enabled with Lyra.DamageLog.Enabled.
+ *
+ *	Recording a hit only copies a small record into a lock-free ring buffer owned by the calling thread.
+ *	A background thread drains the rings and appends the records to a compact binary file in Saved/DamageLogs.
+ *	If a ring fills up faster than the writer drains it, new records are dropped and counted.
+ */
+UCLASS()
+class LYRAGAME_API ULyraDamageEventRecorder : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraDamageEventRecorder();
+	virtual ~ULyraDamageEventRecorder() override;
+
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Records damage dealt to Target by DamageEffectSpec, if the world is recording */
+	static void RecordDamage(UWorld* World, const FGameplayEffectSpec& DamageEffectSpec, const AActor* Target, float Damage, bool bEliminatedTarget);
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	/** Event as produced on gameplay threads, names are resolved to ids by the writer */
+	struct FPendingEvent
+	{
+		double Time = 0.0;
+		FName Instigator;
+		FName Target;
+		FName Weapon;
+		FName HitZone;
+		float Damage = 0.0f;
+		float Distance = 0.0f;
+		ELyraDamageEventFlags Flags = ELyraDamageEventFlags::None;
+	};
+
+	/** Single producer (the owning thread) single consumer (the writer) ring */
+	struct FProducerRing
+	{
+		explicit FProducerRing(uint32 Capacity) : Events(Capacity) {}
+
+		TCircularQueue<FPendingEvent> Events;
+		std::atomic<uint32> NumDropped = 0;
+	};
+
+	class FWriter;
+
+	void Record(FPendingEvent&& Event);
+	FProducerRing& GetRingForCurrentThread();
+	void StopWriter();
+
+	// Unique per recorder, used to find the calling thread's ring without keeping pointers to dead recorders
+	uint32 RecorderId = 0;
+
+	double StartTime = 0.0;
+
+	FCriticalSection RingsLock;
+	TArray<TUniquePtr<FProducerRing>> Rings;
+
+	TUniquePtr<FWriter> Writer;
+	FRunnableThread* WriterThread = nullptr;
+};
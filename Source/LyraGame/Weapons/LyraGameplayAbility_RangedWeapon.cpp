@@ -11,6 +11,10 @@
 #include "AbilitySystem/LyraGameplayAbilityTargetData_SingleTargetHit.h"
 #include "DrawDebugHelpers.h"
 #include "Perception/AISense_Hearing.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Weapons/LyraWeaponImpactSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayAbility_RangedWeapon)
 
@@ -36,6 +40,39 @@ namespace LyraConsoleVariables
 		DrawBulletHitRadius,
 		TEXT("When bullet hit debug drawing is enabled (see DrawBulletHitDuration), how big should the hit radius be? (in uu)"),
 		ECVF_Default);
+
+	static int32 ParallelPelletTraceThreshold = 6;
+	static FAutoConsoleVariableRef CVarParallelPelletTraceThreshold(
+		TEXT("lyra.Weapon.ParallelPelletTraceThreshold"),
+		ParallelPelletTraceThreshold,
+		TEXT("Minimum number of bullets in a cartridge before its traces are spread across worker threads (0 = always trace on the calling thread)"),
+		ECVF_Default);
+
+	static int32 ServerHitValidation = 0;
+	static FAutoConsoleVariableRef CVarServerHitValidation(
+		TEXT("lyra.Weapon.ServerHitValidation"),
+		ServerHitValidation,
+		TEXT("How the server treats pawn hits reported by clients. 0: trust them, 1: re-simulate the seeded cartridge and log mismatches, 2: re-simulate and replace hits that don't match"),
+		ECVF_Default);
+
+	static float ServerHitValidationTolerance = 100.0f;
+	static FAutoConsoleVariableRef CVarServerHitValidationTolerance(
+		TEXT("lyra.Weapon.ServerHitValidationTolerance"),
+		ServerHitValidationTolerance,
+		TEXT("When a re-simulated cartridge misses a pawn the client claims to have hit, still accept it if the pawn is within this distance of one of the pellet rays (in uu, covers latency)"),
+		ECVF_Default);
+
+	static float ServerTraceStartTolerance = 250.0f;
+	static FAutoConsoleVariableRef CVarServerTraceStartTolerance(
+		TEXT("lyra.Weapon.ServerTraceStartTolerance"),
+		ServerTraceStartTolerance,
+		TEXT("How far the trace start reported by a client may be from the server's weapon targeting location before none of the cartridge's pawn hits are confirmed (in uu, covers the camera offset and movement latency)"),
+		ECVF_Default);
+}
+
+static bool ShouldTracePelletsInParallel(int32 NumPellets)
+{
+	return (LyraConsoleVariables::ParallelPelletTraceThreshold > 0) && (NumPellets >= LyraConsoleVariables::ParallelPelletTraceThreshold);
 }
 
 // Weapon fire will be blocked/canceled if the player has this tag
@@ -43,7 +80,7 @@ UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_WeaponFireBlocked, "Ability.Weapon.NoFiring");
 
 //////////////////////////////////////////////////////////////////////
 
-FVector VRandConeNormalDistribution(const FVector& Dir, const float ConeHalfAngleRad, const float Exponent)
+FVector VRandConeNormalDistribution(const FVector& Dir, const float ConeHalfAngleRad, const float Exponent, const FRandomStream& RandomStream)
 {
 	if (ConeHalfAngleRad > 0.f)
 	{
@@ -51,9 +88,9 @@ FVector VRandConeNormalDistribution(const FVector& Dir, const float ConeHalfAngl
 
 		// consider the cone a concatenation of two rotations. one "away" from the center line, and another "around" the circle
 		// apply the exponent to the away-from-center rotation. a larger exponent will cluster points more tightly around the center
-		const float FromCenter = FMath::Pow(FMath::FRand(), Exponent);
+		const float FromCenter = FMath::Pow(RandomStream.FRand(), Exponent);
 		const float AngleFromCenter = FromCenter * ConeHalfAngleDegrees;
-		const float AngleAround = FMath::FRand() * 360.0f;
+		const float AngleAround = RandomStream.FRand() * 360.0f;
 
 		FRotator Rot = Dir.Rotation();
 		FQuat DirQuat(Rot);
@@ -145,26 +182,33 @@ int32 ULyraGameplayAbility_RangedWeapon::FindFirstPawnHitResult(const TArray<FHi
 {
 	for (int32 Idx = 0; Idx < HitResults.Num(); ++Idx)
 	{
-		const FHitResult& CurHitResult = HitResults[Idx];
-		if (CurHitResult.HitObjectHandle.DoesRepresentClass(APawn::StaticClass()))
+		if (IsPawnHitResult(HitResults[Idx]))
 		{
-			// If we hit a pawn, we're good
 			return Idx;
 		}
-		else
-		{
-			AActor* HitActor = CurHitResult.HitObjectHandle.FetchActor();
-			if ((HitActor != nullptr) && (HitActor->GetAttachParentActor() != nullptr) && (Cast<APawn>(HitActor->GetAttachParentActor()) != nullptr))
-			{
-				// If we hit something attached to a pawn, we're good
-				return Idx;
-			}
-		}
 	}
 
 	return INDEX_NONE;
 }
 
+bool ULyraGameplayAbility_RangedWeapon::IsPawnHitResult(const FHitResult& HitResult)
+{
+	if (HitResult.HitObjectHandle.DoesRepresentClass(APawn::StaticClass()))
+	{
+		// If we hit a pawn, we're good
+		return true;
+	}
+
+	// If we hit something attached to a pawn, we're good
+	AActor* HitActor = HitResult.HitObjectHandle.FetchActor();
+	return (HitActor != nullptr) && (HitActor->GetAttachParentActor() != nullptr) && (Cast<APawn>(HitActor->GetAttachParentActor()) != nullptr);
+}
+
+int32 ULyraGameplayAbility_RangedWeapon::MakeCartridgeSeed(int16 PredictionKey, uint16 ShotIndex)
+{
+	return (int32)(((uint32)(uint16)PredictionKey << 16) | ShotIndex);
+}
+
 void ULyraGameplayAbility_RangedWeapon::AddAdditionalTraceIgnoreActors(FCollisionQueryParams& TraceParams) const
 {
 	if (AActor* Avatar = GetAvatarActorFromActorInfo())
@@ -181,24 +225,37 @@ ECollisionChannel ULyraGameplayAbility_RangedWeapon::DetermineTraceChannel(FColl
 	return Lyra_TraceChannel_Weapon;
 }
 
-FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const
+FCollisionQueryParams ULyraGameplayAbility_RangedWeapon::MakeWeaponTraceParams() const
 {
-	TArray<FHitResult> HitResults;
-	
 	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ GetAvatarActorFromActorInfo());
 	TraceParams.bReturnPhysicalMaterial = true;
 	AddAdditionalTraceIgnoreActors(TraceParams);
 	//TraceParams.bDebugQuery = true;
 
+	return TraceParams;
+}
+
+FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const
+{
+	FCollisionQueryParams TraceParams = MakeWeaponTraceParams();
 	const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, bIsSimulated);
 
+	return WeaponTraceWithParams(GetWorld(), StartTrace, EndTrace, SweepRadius, TraceChannel, TraceParams, /*out*/ OutHitResults);
+}
+
+FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTraceWithParams(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, OUT TArray<FHitResult>& OutHitResults)
+{
+	check(World);
+
+	TArray<FHitResult> HitResults;
+
 	if (SweepRadius > 0.0f)
 	{
-		GetWorld()->SweepMultiByChannel(HitResults, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
+		World->SweepMultiByChannel(HitResults, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
 	}
 	else
 	{
-		GetWorld()->LineTraceMultiByChannel(HitResults, StartTrace, EndTrace, TraceChannel, TraceParams);
+		World->LineTraceMultiByChannel(HitResults, StartTrace, EndTrace, TraceChannel, TraceParams);
 	}
 
 	FHitResult Hit(ForceInit);
@@ -337,13 +394,21 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 	}
 #endif // ENABLE_DRAW_DEBUG
 
+	FCollisionQueryParams TraceParams = MakeWeaponTraceParams();
+	const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, bIsSimulated);
+
+	return DoSingleBulletTraceWithParams(GetWorld(), StartTrace, EndTrace, SweepRadius, TraceChannel, TraceParams, /*out*/ OutHits);
+}
+
+FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTraceWithParams(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, OUT TArray<FHitResult>& OutHits)
+{
 	FHitResult Impact;
 
 	// Trace and process instant hit if something was hit
 	// First trace without using sweep radius
 	if (FindFirstPawnHitResult(OutHits) == INDEX_NONE)
 	{
-		Impact = WeaponTrace(StartTrace, EndTrace, /*SweepRadius=*/ 0.0f, bIsSimulated, /*out*/ OutHits);
+		Impact = WeaponTraceWithParams(World, StartTrace, EndTrace, /*SweepRadius=*/ 0.0f, TraceChannel, TraceParams, /*out*/ OutHits);
 	}
 
 	if (FindFirstPawnHitResult(OutHits) == INDEX_NONE)
@@ -352,7 +417,7 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 		if (SweepRadius > 0.0f)
 		{
 			TArray<FHitResult> SweepHits;
-			Impact = WeaponTrace(StartTrace, EndTrace, SweepRadius, bIsSimulated, /*out*/ SweepHits);
+			Impact = WeaponTraceWithParams(World, StartTrace, EndTrace, SweepRadius, TraceChannel, TraceParams, /*out*/ SweepHits);
 
 			// If the trace with sweep radius enabled hit a pawn, check if we should use its hit results
 			const int32 FirstPawnIdx = FindFirstPawnHitResult(SweepHits);
@@ -387,7 +452,34 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 	return Impact;
 }
 
-void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitResult>& OutHits)
+void ULyraGameplayAbility_RangedWeapon::GeneratePelletTraces(const FVector& StartTrace, const FVector& AimDir, float SpreadAngle, float SpreadExponent, double MaxRange, int32 SpreadSeed, int32 NumPellets, TArray<FPelletTrace>& OutPellets)
+{
+	const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(SpreadAngle * 0.5f);
+	const FRandomStream SpreadStream(SpreadSeed);
+
+	OutPellets.SetNum(NumPellets, EAllowShrinking::No);
+	for (FPelletTrace& Pellet : OutPellets)
+	{
+		const FVector BulletDir = VRandConeNormalDistribution(AimDir, HalfSpreadAngleInRadians, SpreadExponent, SpreadStream);
+		Pellet.EndTrace = StartTrace + (BulletDir * MaxRange);
+		Pellet.Hits.Reset();
+	}
+}
+
+void ULyraGameplayAbility_RangedWeapon::TracePelletBatch(const UWorld* World, const FVector& StartTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, TArrayView<FPelletTrace> Pellets, bool bAllowParallel)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraRangedWeapon_TracePelletBatch);
+
+	// Each pellet only writes to its own slot, so the queries can run in any order
+	ParallelFor(Pellets.Num(), [&](int32 PelletIndex)
+		{
+			FPelletTrace& Pellet = Pellets[PelletIndex];
+			Pellet.Impact = DoSingleBulletTraceWithParams(World, StartTrace, Pellet.EndTrace, SweepRadius, TraceChannel, TraceParams, /*out*/ Pellet.Hits);
+		},
+		bAllowParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(int32 SpreadSeed, OUT TArray<FHitResult>& OutHits)
 {
 	APawn* const AvatarPawn = Cast<APawn>(GetAvatarActorFromActorInfo());
 
@@ -397,6 +489,7 @@ void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitRes
 		FRangedWeaponFiringInput InputData;
 		InputData.WeaponData = WeaponData;
 		InputData.bCanPlayBulletFX = (AvatarPawn->GetNetMode() != NM_DedicatedServer);
+		InputData.SpreadSeed = SpreadSeed;
 
 		//@TODO: Should do more complicated logic here when the player is close to a wall, etc...
 		const FTransform TargetTransform = GetTargetingTransform(AvatarPawn, ELyraAbilityTargetingSource::CameraTowardsFocus);
@@ -419,27 +512,47 @@ void ULyraGameplayAbility_RangedWeapon::PerformLocalTargeting(OUT TArray<FHitRes
 
 void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraRangedWeapon_TraceBulletsInCartridge);
+
 	ULyraRangedWeaponInstance* WeaponData = InputData.WeaponData;
 	check(WeaponData);
 
 	const int32 BulletsPerCartridge = WeaponData->GetBulletsPerCartridge();
-
-	for (int32 BulletIndex = 0; BulletIndex < BulletsPerCartridge; ++BulletIndex)
+	if (BulletsPerCartridge <= 0)
 	{
-		// Use weapon instance to determine spread fully (heat, movement, aiming, runtime modifiers).
-		const float BaseSpreadAngle = WeaponData->GetCalculatedSpreadAngle();
-		const float SpreadAngleMultiplier = WeaponData->GetCalculatedSpreadAngleMultiplier();
-		float ActualSpreadAngle = BaseSpreadAngle * SpreadAngleMultiplier;
+		return;
+	}
+
+	// Use weapon instance to determine spread fully (heat, movement, aiming, runtime modifiers).
+	// None of it changes between the bullets of a single cartridge, so it's only evaluated once.
+	const float BaseSpreadAngle = WeaponData->GetCalculatedSpreadAngle();
+	const float SpreadAngleMultiplier = WeaponData->GetCalculatedSpreadAngleMultiplier();
+	const float ActualSpreadAngle = BaseSpreadAngle * SpreadAngleMultiplier;
 
-		const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(ActualSpreadAngle * 0.5f);
+	// Generate every bullet direction up front from the cartridge seed, so the server can reproduce the same pattern
+	GeneratePelletTraces(InputData.StartTrace, InputData.AimDir, ActualSpreadAngle, WeaponData->GetSpreadExponent(), WeaponData->GetMaxDamageRange(), InputData.SpreadSeed, BulletsPerCartridge, /*out*/ PelletTraceScratch);
 
-		const FVector BulletDir = VRandConeNormalDistribution(InputData.AimDir, HalfSpreadAngleInRadians, WeaponData->GetSpreadExponent());
+#if ENABLE_DRAW_DEBUG
+	if (LyraConsoleVariables::DrawBulletTracesDuration > 0.0f)
+	{
+		static float DebugThickness = 1.0f;
+		for (const FPelletTrace& Pellet : PelletTraceScratch)
+		{
+			DrawDebugLine(GetWorld(), InputData.StartTrace, Pellet.EndTrace, FColor::Red, false, LyraConsoleVariables::DrawBulletTracesDuration, 0, DebugThickness);
+		}
+	}
+#endif // ENABLE_DRAW_DEBUG
 
-		const FVector EndTrace = InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange());
+	// The ignore list and channel are the same for every bullet, build them once for the whole cartridge
+	FCollisionQueryParams TraceParams = MakeWeaponTraceParams();
+	const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, /*bIsSimulated=*/ false);
 
-		TArray<FHitResult> AllImpacts;
+	TracePelletBatch(GetWorld(), InputData.StartTrace, WeaponData->GetBulletTraceSweepRadius(), TraceChannel, TraceParams, PelletTraceScratch, ShouldTracePelletsInParallel(BulletsPerCartridge));
 
-		FHitResult Impact = DoSingleBulletTrace(InputData.StartTrace, EndTrace, WeaponData->GetBulletTraceSweepRadius(), /*bIsSimulated=*/ false, /*out*/ AllImpacts);
+	// Merge the results in bullet order
+	for (FPelletTrace& Pellet : PelletTraceScratch)
+	{
+		FHitResult& Impact = Pellet.Impact;
 
 		const AActor* HitActor = Impact.GetActor();
 
@@ -452,9 +565,9 @@ void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWea
 			}
 #endif
 
-			if (AllImpacts.Num() > 0)
+			if (Pellet.Hits.Num() > 0)
 			{
-				OutHits.Append(AllImpacts);
+				OutHits.Append(Pellet.Hits);
 			}
 		}
 
@@ -464,8 +577,8 @@ void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWea
 			if (!Impact.bBlockingHit)
 			{
 				// Locate the fake 'impact' at the end of the trace
-				Impact.Location = EndTrace;
-				Impact.ImpactPoint = EndTrace;
+				Impact.Location = Pellet.EndTrace;
+				Impact.ImpactPoint = Pellet.EndTrace;
 			}
 
 			OutHits.Add(Impact);
@@ -473,6 +586,106 @@ void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWea
 	}
 }
 
+void ULyraGameplayAbility_RangedWeapon::ValidateTargetDataOnServer(FGameplayAbilityTargetDataHandle& TargetData, int32 ExpectedCartridgeID)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraRangedWeapon_ValidateTargetDataOnServer);
+
+	ULyraRangedWeaponInstance* WeaponData = GetWeaponInstance();
+	UWorld* World = GetWorld();
+	if ((WeaponData == nullptr) || (World == nullptr))
+	{
+		return;
+	}
+
+	const bool bRejectMismatches = (LyraConsoleVariables::ServerHitValidation >= 2);
+
+	auto GetLyraHit = [&TargetData](int32 Index) -> FLyraGameplayAbilityTargetData_SingleTargetHit*
+	{
+		FGameplayAbilityTargetData* Data = TargetData.Get(Index);
+		return ((Data != nullptr) && (Data->GetScriptStruct() == FLyraGameplayAbilityTargetData_SingleTargetHit::StaticStruct())) ? static_cast<FLyraGameplayAbilityTargetData_SingleTargetHit*>(Data) : nullptr;
+	};
+
+	// The aim direction only travels with the first hit of the cartridge
+	const FLyraGameplayAbilityTargetData_SingleTargetHit* CartridgeHit = nullptr;
+	for (int32 HitIndex = 0; (HitIndex < TargetData.Num()) && (CartridgeHit == nullptr); ++HitIndex)
+	{
+		const FLyraGameplayAbilityTargetData_SingleTargetHit* LyraHit = GetLyraHit(HitIndex);
+		if ((LyraHit != nullptr) && !LyraHit->AimDir.IsZero())
+		{
+			CartridgeHit = LyraHit;
+		}
+	}
+
+	// The re-simulation starts from the client's trace start, so it has to be somewhere the server agrees the weapon could be,
+	// otherwise a client could place the origin of the spread cone wherever it suits it
+	if (CartridgeHit != nullptr)
+	{
+		const FVector ServerSourceLocation = GetWeaponTargetingSourceLocation();
+		const double TraceStartError = FVector::Dist(CartridgeHit->HitResult.TraceStart, ServerSourceLocation);
+		if (TraceStartError > LyraConsoleVariables::ServerTraceStartTolerance)
+		{
+			UE_LOG(LogLyraAbilitySystem, Warning, TEXT("%s: client trace start is %.0f uu from the server's weapon location, not confirming cartridge %d"),
+				*GetName(), TraceStartError, ExpectedCartridgeID);
+			CartridgeHit = nullptr;
+		}
+	}
+
+	if (CartridgeHit != nullptr)
+	{
+		FCollisionQueryParams TraceParams = MakeWeaponTraceParams();
+		const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, /*bIsSimulated=*/ false);
+
+		// Spread comes from the server's copy of the weapon, it tracks the client closely since both sides apply the same heat.
+		// The seed is the one we expect for this shot, not whatever the client put in the target data.
+		const float ActualSpreadAngle = WeaponData->GetCalculatedSpreadAngle() * WeaponData->GetCalculatedSpreadAngleMultiplier();
+		GeneratePelletTraces(CartridgeHit->HitResult.TraceStart, CartridgeHit->AimDir, ActualSpreadAngle, WeaponData->GetSpreadExponent(), WeaponData->GetMaxDamageRange(), ExpectedCartridgeID, WeaponData->GetBulletsPerCartridge(), /*out*/ PelletTraceScratch);
+		TracePelletBatch(World, CartridgeHit->HitResult.TraceStart, WeaponData->GetBulletTraceSweepRadius(), TraceChannel, TraceParams, PelletTraceScratch, ShouldTracePelletsInParallel(PelletTraceScratch.Num()));
+	}
+
+	for (int32 HitIndex = 0; HitIndex < TargetData.Num(); ++HitIndex)
+	{
+		FLyraGameplayAbilityTargetData_SingleTargetHit* ClaimedHit = GetLyraHit(HitIndex);
+		if ((ClaimedHit == nullptr) || !IsPawnHitResult(ClaimedHit->HitResult))
+		{
+			// Only pawn hits matter, impacts against the world are purely cosmetic
+			continue;
+		}
+
+		const AActor* ClaimedActor = ClaimedHit->HitResult.GetActor();
+
+		// A different seed (wrong activation or a shot index the client skipped or replayed) means the client picked its own pattern
+		bool bConfirmed = false;
+		if ((CartridgeHit != nullptr) && (ClaimedHit->CartridgeID == ExpectedCartridgeID) && (ClaimedActor != nullptr))
+		{
+			const FVector ClaimedLocation = ClaimedActor->GetActorLocation();
+			for (const FPelletTrace& Pellet : PelletTraceScratch)
+			{
+				const bool bPelletHitActor = Pellet.Hits.ContainsByPredicate([ClaimedActor](const FHitResult& Hit) { return Hit.GetActor() == ClaimedActor; });
+				if (bPelletHitActor || (FMath::PointDistToSegment(ClaimedLocation, CartridgeHit->HitResult.TraceStart, Pellet.EndTrace) <= LyraConsoleVariables::ServerHitValidationTolerance))
+				{
+					bConfirmed = true;
+					break;
+				}
+			}
+		}
+
+		if (!bConfirmed)
+		{
+			UE_LOG(LogLyraAbilitySystem, Warning, TEXT("%s: client hit on %s (cartridge %d, expected %d) was not reproduced by the server%s"),
+				*GetName(), *GetNameSafe(ClaimedActor), ClaimedHit->CartridgeID, ExpectedCartridgeID, bRejectMismatches ? TEXT(", rejecting it") : TEXT(""));
+
+			if (bRejectMismatches)
+			{
+				// Leave the entry in place so hit marker indices still line up on the client, but drop the target
+				ClaimedHit->bHitReplaced = true;
+				ClaimedHit->HitResult.HitObjectHandle = FActorInstanceHandle();
+				ClaimedHit->HitResult.Component.Reset();
+				ClaimedHit->HitResult.bBlockingHit = false;
+			}
+		}
+	}
+}
+
 void ULyraGameplayAbility_RangedWeapon::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
 	// Bind target data callback
@@ -486,6 +699,9 @@ void ULyraGameplayAbility_RangedWeapon::ActivateAbility(const FGameplayAbilitySp
 	check(WeaponData);
 	WeaponData->UpdateFiringTime();
 
+	// Shots are counted per activation, the client and the server count them in the same order
+	NextShotIndex = 0;
+
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 }
 
@@ -537,6 +753,17 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			{
 				if (Controller->GetLocalRole() == ROLE_Authority)
 				{
+					// Check the client's hits against our own re-simulation of its cartridge before confirming anything.
+					// Target data arrives once per shot, in order, so we know which seed the client had to use.
+					if (!CurrentActorInfo->IsLocallyControlled())
+					{
+						const int32 ExpectedCartridgeID = MakeCartridgeSeed(CurrentActivationInfo.GetActivationPredictionKey().Current, NextShotIndex++);
+						if (LyraConsoleVariables::ServerHitValidation > 0)
+						{
+							ValidateTargetDataOnServer(LocalTargetDataHandle, ExpectedCartridgeID);
+						}
+					}
+
 					// Confirm hit markers
 					if (ULyraWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<ULyraWeaponStateComponent>())
 					{
@@ -596,6 +823,15 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			}
 #endif // WITH_SERVER_CODE
 
+			// Impacts are cosmetic, so there is no impact subsystem on dedicated servers
+			if (ImpactCueTag.IsValid())
+			{
+				if (ULyraWeaponImpactSubsystem* ImpactSubsystem = UWorld::GetSubsystem<ULyraWeaponImpactSubsystem>(GetWorld()))
+				{
+					ImpactSubsystem->QueueImpactsFromTargetData(GetAvatarActorFromActorInfo(), ImpactCueTag, LocalTargetDataHandle);
+				}
+			}
+
 			// Let the blueprint do stuff like apply effects to the targets
 			OnRangedWeaponTargetDataReady(LocalTargetDataHandle);
 		}
@@ -626,8 +862,11 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	FScopedPredictionWindow ScopedPrediction(MyAbilityComponent, CurrentActivationInfo.GetActivationPredictionKey());
 
+	// The cartridge ID seeds the spread, so the server can rebuild the pellet pattern without us sending every direction
+	const int32 CartridgeID = MakeCartridgeSeed(CurrentActivationInfo.GetActivationPredictionKey().Current, NextShotIndex++);
+
 	TArray<FHitResult> FoundHits;
-	PerformLocalTargeting(/*out*/ FoundHits);
+	PerformLocalTargeting(CartridgeID, /*out*/ FoundHits);
 
 	// Fill out the target data from the hit results
 	FGameplayAbilityTargetDataHandle TargetData;
@@ -635,14 +874,18 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	if (FoundHits.Num() > 0)
 	{
-		const int32 CartridgeID = FMath::Rand();
-
 		for (const FHitResult& FoundHit : FoundHits)
 		{
 			FLyraGameplayAbilityTargetData_SingleTargetHit* NewTargetData = new FLyraGameplayAbilityTargetData_SingleTargetHit();
 			NewTargetData->HitResult = FoundHit;
 			NewTargetData->CartridgeID = CartridgeID;
 
+			// The server only needs the aim direction once per cartridge to rebuild every pellet
+			if (TargetData.Num() == 0)
+			{
+				NewTargetData->AimDir = GetTargetingTransform(CastChecked<APawn>(AvatarActor), ELyraAbilityTargetingSource::CameraTowardsFocus).GetUnitAxis(EAxis::X);
+			}
+
 			TargetData.Add(NewTargetData);
 		}
 	}
@@ -656,3 +899,80 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 	// Process the target data immediately
 	OnTargetDataReadyCallback(TargetData, FGameplayTag());
 }
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs CVarBenchmarkPelletTraces(
+	TEXT("lyra.Weapon.BenchmarkPelletTraces"),
+	TEXT("Times tracing cartridges of pellets from the first player's view, on the calling thread and as a parallel batch. Usage: lyra.Weapon.BenchmarkPelletTraces [Pellets=12] [Cartridges=600] [SpreadDegrees=10] [SweepRadius=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+		[](const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumPellets = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 12;
+	const int32 NumCartridges = (Args.Num() > 1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 600;
+	const float SpreadDegrees = (Args.Num() > 2) ? FMath::Max(0.0f, FCString::Atof(*Args[2])) : 10.0f;
+	const float SweepRadius = (Args.Num() > 3) ? FMath::Max(0.0f, FCString::Atof(*Args[3])) : 0.0f;
+	const double TraceRange = 25000.0;
+
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (PC == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("lyra.Weapon.BenchmarkPelletTraces: no player controller to trace from"));
+		return;
+	}
+
+	FVector ViewLoc;
+	FRotator ViewRot;
+	PC->GetPlayerViewPoint(/*out*/ ViewLoc, /*out*/ ViewRot);
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ PC->GetPawn());
+	TraceParams.bReturnPhysicalMaterial = true;
+
+	// Both passes trace the exact same directions
+	const FRandomStream SpreadStream(NumPellets);
+	TArray<FVector> EndTraces;
+	EndTraces.Reserve(NumPellets * NumCartridges);
+	for (int32 Index = 0; Index < NumPellets * NumCartridges; ++Index)
+	{
+		EndTraces.Add(ViewLoc + VRandConeNormalDistribution(ViewRot.Vector(), FMath::DegreesToRadians(SpreadDegrees * 0.5f), 1.0f, SpreadStream) * TraceRange);
+	}
+
+	TArray<ULyraGameplayAbility_RangedWeapon::FPelletTrace> Pellets;
+	Pellets.SetNum(NumPellets);
+
+	auto RunPass = [&](bool bAllowParallel, int32& OutNumHits)
+	{
+		OutNumHits = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Cartridge = 0; Cartridge < NumCartridges; ++Cartridge)
+		{
+			for (int32 PelletIndex = 0; PelletIndex < NumPellets; ++PelletIndex)
+			{
+				Pellets[PelletIndex].EndTrace = EndTraces[(Cartridge * NumPellets) + PelletIndex];
+				Pellets[PelletIndex].Hits.Reset();
+			}
+
+			ULyraGameplayAbility_RangedWeapon::TracePelletBatch(World, ViewLoc, SweepRadius, Lyra_TraceChannel_Weapon, TraceParams, Pellets, bAllowParallel);
+
+			for (const ULyraGameplayAbility_RangedWeapon::FPelletTrace& Pellet : Pellets)
+			{
+				OutNumHits += Pellet.Hits.Num();
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	int32 SerialHits = 0;
+	int32 ParallelHits = 0;
+	const double SerialSeconds = RunPass(/*bAllowParallel=*/ false, SerialHits);
+	const double ParallelSeconds = RunPass(/*bAllowParallel=*/ true, ParallelHits);
+
+	UE_LOG(LogLyra, Display, TEXT("lyra.Weapon.BenchmarkPelletTraces (%s): %d cartridges x %d pellets. Serial: %.3f ms (%.1f us/cartridge, %d hits). Parallel: %.3f ms (%.1f us/cartridge, %d hits)"),
+		World->IsNetMode(NM_Client) ? TEXT("client") : TEXT("server"), NumCartridges, NumPellets,
+		SerialSeconds * 1000.0, (SerialSeconds * 1.0e6) / NumCartridges, SerialHits,
+		ParallelSeconds * 1000.0, (ParallelSeconds * 1.0e6) / NumCartridges, ParallelHits);
+}));
+
+#endif // !UE_BUILD_SHIPPING
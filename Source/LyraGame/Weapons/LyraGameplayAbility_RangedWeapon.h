@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Equipment/LyraGameplayAbility_FromEquipment.h"
+#include "Engine/HitResult.h"
+#include "GameplayTagContainer.h"
 
 #include "LyraGameplayAbility_RangedWeapon.generated.h"
 
@@ -11,6 +13,7 @@ enum ECollisionChannel : int;
 class APawn;
 class ULyraRangedWeaponInstance;
 class UObject;
+class UWorld;
 struct FCollisionQueryParams;
 struct FFrame;
 struct FGameplayAbilityActorInfo;
@@ -67,6 +70,14 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category="Lyra|Ability|RangedWeapon|Accuracy")
 	float RuntimeAccuracySpreadMultiplier = 1.0f;
 
+	/**
+	 * Impact cue for the hits of every cartridge. When set, the hits are queued on ULyraWeaponImpactSubsystem on the machine that
+	 * fired (and on a listen server), which batches them per frame and spawns pooled effects, so the blueprint should stop
+	 * executing this cue locally. Other clients still only see what the blueprint replicates.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Lyra|Ability|RangedWeapon|Impacts", meta=(Categories="GameplayCue"))
+	FGameplayTag ImpactCueTag;
+
 	/** Set the runtime accuracy spread multiplier (0+). 1.0 means no extra change on top of AccuracySpreadMultiplier. */
 	UFUNCTION(BlueprintCallable, Category="Lyra|Ability|RangedWeapon|Accuracy")
 	void SetRuntimeAccuracySpreadMultiplier(float NewMultiplier);
@@ -89,6 +100,26 @@ public:
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	//~End of UGameplayAbility interface
 
+	// Scratch storage for a single pellet when tracing a whole cartridge as one batch
+	struct FPelletTrace
+	{
+		// End of the trace after spread has been applied
+		FVector EndTrace = FVector::ZeroVector;
+
+		// Representative impact of the pellet (as returned by DoSingleBulletTrace)
+		FHitResult Impact;
+
+		// All hits for the pellet, keeps its allocation between cartridges
+		TArray<FHitResult> Hits;
+	};
+
+	// Fills NumPellets end points of a cartridge, using a random stream seeded with SpreadSeed so the same seed always produces the same pattern
+	static void GeneratePelletTraces(const FVector& StartTrace, const FVector& AimDir, float SpreadAngle, float SpreadExponent, double MaxRange, int32 SpreadSeed, int32 NumPellets, TArray<FPelletTrace>& OutPellets);
+
+	// Traces every pellet in Pellets from StartTrace, fanning the scene queries out to worker threads when bAllowParallel is set.
+	// Queries are read-only, so the only requirement is that nothing mutates the physics scene while the batch is in flight (the calling thread blocks until it completes).
+	static void TracePelletBatch(const UWorld* World, const FVector& StartTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, TArrayView<FPelletTrace> Pellets, bool bAllowParallel);
+
 protected:
 	struct FRangedWeaponFiringInput
 	{
@@ -107,6 +138,9 @@ protected:
 		// Can we play bullet FX for hits during this trace
 		bool bCanPlayBulletFX = false;
 
+		// Seed for the spread pattern of this cartridge (see MakeCartridgeSeed)
+		int32 SpreadSeed = 0;
+
 		FRangedWeaponFiringInput()
 			: StartTrace(ForceInitToZero)
 			, EndAim(ForceInitToZero)
@@ -117,6 +151,13 @@ protected:
 
 protected:
 	static int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults);
+	static bool IsPawnHitResult(const FHitResult& HitResult);
+
+	// Packs the activation prediction key and a per-activation shot counter into the cartridge ID, which doubles as the spread seed
+	static int32 MakeCartridgeSeed(int16 PredictionKey, uint16 ShotIndex);
+
+	// Builds the query params shared by every weapon trace of this ability (ignores the avatar and anything attached to it)
+	FCollisionQueryParams MakeWeaponTraceParams() const;
 
 	// Does a single weapon trace, either sweeping or ray depending on if SweepRadius is above zero
 	FHitResult WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const;
@@ -124,6 +165,10 @@ protected:
 	// Wrapper around WeaponTrace to handle trying to do a ray trace before falling back to a sweep trace if there were no hits and SweepRadius is above zero 
 	FHitResult DoSingleBulletTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHits) const;
 
+	// Versions of WeaponTrace / DoSingleBulletTrace that work from prebuilt query params, safe to call from worker threads
+	static FHitResult WeaponTraceWithParams(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, OUT TArray<FHitResult>& OutHitResults);
+	static FHitResult DoSingleBulletTraceWithParams(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, ECollisionChannel TraceChannel, const FCollisionQueryParams& TraceParams, OUT TArray<FHitResult>& OutHits);
+
 	// Traces all of the bullets in a single cartridge
 	void TraceBulletsInCartridge(const FRangedWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits);
 
@@ -132,7 +177,10 @@ protected:
 	// Determine the trace channel to use for the weapon trace(s)
 	virtual ECollisionChannel DetermineTraceChannel(FCollisionQueryParams& TraceParams, bool bIsSimulated) const;
 
-	void PerformLocalTargeting(OUT TArray<FHitResult>& OutHits);
+	void PerformLocalTargeting(int32 SpreadSeed, OUT TArray<FHitResult>& OutHits);
+
+	// Re-traces the cartridge in TargetData from the seed the server expects for this shot and checks the claimed pawn hits against the result (see lyra.Weapon.ServerHitValidation)
+	void ValidateTargetDataOnServer(FGameplayAbilityTargetDataHandle& TargetData, int32 ExpectedCartridgeID);
 
 	FVector GetWeaponTargetingSourceLocation() const;
 	FTransform GetTargetingTransform(APawn* SourcePawn, ELyraAbilityTargetingSource Source) const;
@@ -148,4 +196,11 @@ protected:
 
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
+
+	// Per-pellet storage reused by TraceBulletsInCartridge so multi-pellet weapons don't allocate every shot
+	TArray<FPelletTrace> PelletTraceScratch;
+
+	// Number of cartridges fired in the current activation, combined with the prediction key to seed the spread.
+	// On the server this is the shot index expected from the next target data a remote client sends.
+	uint16 NextShotIndex = 0;
 };
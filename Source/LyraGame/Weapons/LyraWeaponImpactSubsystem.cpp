@@ -0,0 +1,410 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraWeaponImpactSubsystem.h"
+
+#include "AbilitySystem/LyraGameplayEffectContext.h"
+#include "AbilitySystemGlobals.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Components/DecalComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameplayCueManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInterface.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWeaponImpactSubsystem)
+
+namespace LyraConsoleVariables
+{
+	static float ImpactMergeDistance = 15.0f;
+	static FAutoConsoleVariableRef CVarImpactMergeDistance(
+		TEXT("lyra.Weapon.Impacts.MergeDistance"),
+		ImpactMergeDistance,
+		TEXT("Impacts of the same cue on the same component closer than this (in uu) during a frame are merged into one"),
+		ECVF_Default);
+
+	static int32 MaxImpactSpawnsPerFrame = 32;
+	static FAutoConsoleVariableRef CVarMaxImpactSpawnsPerFrame(
+		TEXT("lyra.Weapon.Impacts.MaxSpawnsPerFrame"),
+		MaxImpactSpawnsPerFrame,
+		TEXT("Maximum number of impacts turned into effects per frame, the ones furthest from the local view are dropped first (0 = no limit)"),
+		ECVF_Default);
+
+	static int32 ImpactDecalPoolSize = 64;
+	static FAutoConsoleVariableRef CVarImpactDecalPoolSize(
+		TEXT("lyra.Weapon.Impacts.DecalPoolSize"),
+		ImpactDecalPoolSize,
+		TEXT("Number of decal components kept around for natively spawned impacts, the oldest decal is reused when they are all in use"),
+		ECVF_Default);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpWeaponImpactStats(
+	TEXT("lyra.Weapon.Impacts.DumpStats"),
+	TEXT("Shows how many weapon impacts were queued, merged, culled and spawned"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
+		[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	if (const ULyraWeaponImpactSubsystem* ImpactSubsystem = World ? World->GetSubsystem<ULyraWeaponImpactSubsystem>() : nullptr)
+	{
+		ImpactSubsystem->DumpStats(Ar);
+	}
+	else
+	{
+		Ar.Logf(TEXT("No weapon impact subsystem in this world"));
+	}
+}));
+
+//////////////////////////////////////////////////////////////////////
+// ULyraWeaponImpactSubsystem
+
+bool ULyraWeaponImpactSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Impacts are purely cosmetic
+	if (IsRunningDedicatedServer())
+	{
+		return false;
+	}
+
+	return Super::ShouldCreateSubsystem(Outer);
+}
+
+bool ULyraWeaponImpactSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void ULyraWeaponImpactSubsystem::Deinitialize()
+{
+	PendingBatches.Reset();
+
+	for (UDecalComponent* Decal : DecalPool)
+	{
+		if (IsValid(Decal))
+		{
+			Decal->DestroyComponent();
+		}
+	}
+	DecalPool.Reset();
+	DecalExpireTimes.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId ULyraWeaponImpactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraWeaponImpactSubsystem, STATGROUP_Tickables);
+}
+
+void ULyraWeaponImpactSubsystem::Tick(float DeltaTime)
+{
+	if (!PendingBatches.IsEmpty())
+	{
+		FlushImpacts();
+	}
+
+	ExpireDecals();
+}
+
+void ULyraWeaponImpactSubsystem::QueueImpact(AActor* Instigator, FGameplayTag CueTag, const FHitResult& Impact)
+{
+	if (!CueTag.IsValid())
+	{
+		return;
+	}
+
+	FPendingImpactBatch* Batch = PendingBatches.FindByPredicate([Instigator, &CueTag](const FPendingImpactBatch& Existing)
+		{
+			return (Existing.CueTag == CueTag) && (Existing.Instigator == Instigator);
+		});
+
+	if (Batch == nullptr)
+	{
+		Batch = &PendingBatches.AddDefaulted_GetRef();
+		Batch->Instigator = Instigator;
+		Batch->CueTag = CueTag;
+	}
+
+	++Stats.Queued;
+
+	// Merge with an impact already queued this frame if it would look the same
+	const double MergeDistanceSq = FMath::Square((double)LyraConsoleVariables::ImpactMergeDistance);
+	const bool bMerged = Batch->Impacts.ContainsByPredicate([&Impact, MergeDistanceSq](const FHitResult& Existing)
+		{
+			return (Existing.Component == Impact.Component) && (FVector::DistSquared(Existing.ImpactPoint, Impact.ImpactPoint) <= MergeDistanceSq);
+		});
+
+	if (bMerged)
+	{
+		++Stats.Merged;
+		return;
+	}
+
+	Batch->Impacts.Add(Impact);
+}
+
+void ULyraWeaponImpactSubsystem::QueueImpactsFromTargetData(AActor* Instigator, FGameplayTag CueTag, const FGameplayAbilityTargetDataHandle& TargetData)
+{
+	for (int32 Index = 0; Index < TargetData.Num(); ++Index)
+	{
+		const FGameplayAbilityTargetData* Data = TargetData.Get(Index);
+		if ((Data != nullptr) && Data->HasHitResult())
+		{
+			QueueImpact(Instigator, CueTag, *Data->GetHitResult());
+		}
+	}
+}
+
+TArray<FHitResult> ULyraWeaponImpactSubsystem::GetImpactsFromCueParameters(const FGameplayCueParameters& Parameters)
+{
+	if (const FLyraGameplayEffectContext* LyraContext = FLyraGameplayEffectContext::ExtractEffectContext(Parameters.EffectContext))
+	{
+		if (!LyraContext->BatchedImpacts.IsEmpty())
+		{
+			return LyraContext->BatchedImpacts;
+		}
+	}
+
+	TArray<FHitResult> Impacts;
+	if (const FHitResult* HitResult = Parameters.EffectContext.GetHitResult())
+	{
+		Impacts.Add(*HitResult);
+	}
+	return Impacts;
+}
+
+void ULyraWeaponImpactSubsystem::FlushImpacts()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraWeaponImpactSubsystem_FlushImpacts);
+
+	CullImpactsBySignificance();
+
+	for (FPendingImpactBatch& Batch : PendingBatches)
+	{
+		if (Batch.Impacts.IsEmpty())
+		{
+			continue;
+		}
+
+		if (SpawnNativeImpacts(Batch))
+		{
+			Stats.SpawnedNative += Batch.Impacts.Num();
+		}
+		else
+		{
+			ExecuteBatchedCue(Batch);
+		}
+	}
+
+	PendingBatches.Reset();
+}
+
+void ULyraWeaponImpactSubsystem::CullImpactsBySignificance()
+{
+	// Significance is the distance to the closest local view
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PC = Iterator->Get();
+		if ((PC != nullptr) && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	auto GetViewDistanceSq = [&ViewLocations](const FHitResult& Impact)
+	{
+		double BestDistanceSq = ViewLocations.IsEmpty() ? 0.0 : TNumericLimits<double>::Max();
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			BestDistanceSq = FMath::Min(BestDistanceSq, FVector::DistSquared(ViewLocation, Impact.ImpactPoint));
+		}
+		return BestDistanceSq;
+	};
+
+	// Most significant impact first in each batch, it's the one used for the single per-batch sound and the cue's hit result
+	int32 TotalImpacts = 0;
+	for (FPendingImpactBatch& Batch : PendingBatches)
+	{
+		Batch.Impacts.Sort([&GetViewDistanceSq](const FHitResult& A, const FHitResult& B) { return GetViewDistanceSq(A) < GetViewDistanceSq(B); });
+		TotalImpacts += Batch.Impacts.Num();
+	}
+
+	const int32 MaxSpawns = LyraConsoleVariables::MaxImpactSpawnsPerFrame;
+	if ((MaxSpawns <= 0) || (TotalImpacts <= MaxSpawns))
+	{
+		return;
+	}
+
+	// Find the distance of the last impact that still makes the cut across every batch
+	TArray<double> AllDistancesSq;
+	AllDistancesSq.Reserve(TotalImpacts);
+	for (const FPendingImpactBatch& Batch : PendingBatches)
+	{
+		for (const FHitResult& Impact : Batch.Impacts)
+		{
+			AllDistancesSq.Add(GetViewDistanceSq(Impact));
+		}
+	}
+	AllDistancesSq.Sort();
+	const double CutoffDistanceSq = AllDistancesSq[MaxSpawns - 1];
+
+	int32 NumKept = 0;
+	for (FPendingImpactBatch& Batch : PendingBatches)
+	{
+		int32 NumToKeep = 0;
+		while ((NumToKeep < Batch.Impacts.Num()) && (NumKept < MaxSpawns) && (GetViewDistanceSq(Batch.Impacts[NumToKeep]) <= CutoffDistanceSq))
+		{
+			++NumToKeep;
+			++NumKept;
+		}
+
+		Stats.Culled += Batch.Impacts.Num() - NumToKeep;
+		Batch.Impacts.SetNum(NumToKeep, EAllowShrinking::No);
+	}
+}
+
+bool ULyraWeaponImpactSubsystem::SpawnNativeImpacts(const FPendingImpactBatch& Batch)
+{
+	const FLyraWeaponImpactEffect* Effect = GetDefault<ULyraWeaponImpactSettings>()->NativeImpactEffects.Find(Batch.CueTag);
+	if (Effect == nullptr)
+	{
+		return false;
+	}
+
+	// Never block on these, fall back to the cue until they've streamed in
+	TArray<FSoftObjectPath> PathsToLoad;
+	auto ResolveAsset = [&PathsToLoad](const auto& SoftPtr)
+	{
+		auto* Asset = SoftPtr.Get();
+		if ((Asset == nullptr) && !SoftPtr.IsNull())
+		{
+			PathsToLoad.Add(SoftPtr.ToSoftObjectPath());
+		}
+		return Asset;
+	};
+
+	UNiagaraSystem* NiagaraSystem = ResolveAsset(Effect->NiagaraSystem);
+	UMaterialInterface* DecalMaterial = ResolveAsset(Effect->DecalMaterial);
+	USoundBase* Sound = ResolveAsset(Effect->Sound);
+
+	if (!PathsToLoad.IsEmpty())
+	{
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToLoad));
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	for (const FHitResult& Impact : Batch.Impacts)
+	{
+		if (NiagaraSystem != nullptr)
+		{
+			UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, NiagaraSystem, Impact.ImpactPoint, Impact.ImpactNormal.Rotation(), FVector(1.0f), /*bAutoDestroy=*/ false, /*bAutoActivate=*/ true, ENCPoolMethod::AutoRelease);
+		}
+
+		if (DecalMaterial != nullptr)
+		{
+			PlaceDecal(*Effect, DecalMaterial, Impact);
+		}
+	}
+
+	if (Sound != nullptr)
+	{
+		UGameplayStatics::PlaySoundAtLocation(World, Sound, Batch.Impacts[0].ImpactPoint);
+	}
+
+	return true;
+}
+
+void ULyraWeaponImpactSubsystem::ExecuteBatchedCue(FPendingImpactBatch& Batch)
+{
+	AActor* Instigator = Batch.Instigator.Get();
+	if (Instigator == nullptr)
+	{
+		return;
+	}
+
+	const FHitResult& MostSignificantImpact = Batch.Impacts[0];
+
+	FLyraGameplayEffectContext* Context = new FLyraGameplayEffectContext(Instigator, Instigator);
+	Context->AddHitResult(MostSignificantImpact, /*bReset=*/ true);
+
+	FGameplayCueParameters Parameters;
+	Parameters.Location = MostSignificantImpact.ImpactPoint;
+	Parameters.Normal = MostSignificantImpact.ImpactNormal;
+	Parameters.PhysicalMaterial = MostSignificantImpact.PhysMaterial;
+	Parameters.Instigator = Instigator;
+	Parameters.EffectCauser = Instigator;
+
+	Stats.SpawnedThroughCues += Batch.Impacts.Num();
+	++Stats.CueExecutions;
+
+	Context->BatchedImpacts = MoveTemp(Batch.Impacts);
+	Parameters.EffectContext = FGameplayEffectContextHandle(Context);
+
+	UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(Instigator, Batch.CueTag, EGameplayCueEvent::Executed, Parameters);
+}
+
+void ULyraWeaponImpactSubsystem::PlaceDecal(const FLyraWeaponImpactEffect& Effect, UMaterialInterface* DecalMaterial, const FHitResult& Impact)
+{
+	const int32 PoolSize = FMath::Max(1, LyraConsoleVariables::ImpactDecalPoolSize);
+	UWorld* World = GetWorld();
+
+	UDecalComponent* Decal = nullptr;
+	int32 DecalIndex = INDEX_NONE;
+	if (DecalPool.Num() < PoolSize)
+	{
+		Decal = NewObject<UDecalComponent>(World->GetWorldSettings(), NAME_None, RF_Transient);
+		Decal->bAllowAnyoneToDestroyMe = true;
+		Decal->RegisterComponentWithWorld(World);
+
+		DecalIndex = DecalPool.Add(Decal);
+		DecalExpireTimes.Add(0.0);
+	}
+	else
+	{
+		DecalIndex = NextDecalIndex % DecalPool.Num();
+		NextDecalIndex = DecalIndex + 1;
+		Decal = DecalPool[DecalIndex];
+	}
+
+	if (!IsValid(Decal))
+	{
+		return;
+	}
+
+	Decal->SetDecalMaterial(DecalMaterial);
+	Decal->DecalSize = Effect.DecalSize;
+	Decal->SetWorldLocationAndRotation(Impact.ImpactPoint, (-Impact.ImpactNormal).Rotation());
+	Decal->SetVisibility(true);
+	Decal->MarkRenderStateDirty();
+
+	DecalExpireTimes[DecalIndex] = World->GetTimeSeconds() + Effect.DecalLifeSpan;
+}
+
+void ULyraWeaponImpactSubsystem::ExpireDecals()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 Index = 0; Index < DecalPool.Num(); ++Index)
+	{
+		UDecalComponent* Decal = DecalPool[Index];
+		if (IsValid(Decal) && Decal->IsVisible() && (DecalExpireTimes[Index] <= Now))
+		{
+			Decal->SetVisibility(false);
+		}
+	}
+}
+
+void ULyraWeaponImpactSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Weapon impacts: %lld queued, %lld merged, %lld culled by significance"), Stats.Queued, Stats.Merged, Stats.Culled);
+	Ar.Logf(TEXT("  %lld spawned natively (%d pooled decals), %lld spawned through %lld batched cue executions"),
+		Stats.SpawnedNative, DecalPool.Num(), Stats.SpawnedThroughCues, Stats.CueExecutions);
+}
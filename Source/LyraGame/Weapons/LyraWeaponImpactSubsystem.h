@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "Engine/HitResult.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraWeaponImpactSubsystem.generated.h"
+
+class AActor;
+class FOutputDevice;
+class UDecalComponent;
+class UMaterialInterface;
+class UNiagaraSystem;
+class USoundBase;
+struct FGameplayAbilityTargetDataHandle;
+struct FGameplayCueParameters;
+
+/** Effects spawned directly (without going through a gameplay cue notify) for every impact of a cue tag */
+USTRUCT()
+struct FLyraWeaponImpactEffect
+{
+	GENERATED_BODY()
+
+	// Niagara system spawned at each impact, from the world's Niagara component pool
+	UPROPERTY(EditAnywhere, Category=Impact)
+	TSoftObjectPtr<UNiagaraSystem> NiagaraSystem;
+
+	// Decal placed at each impact, from the subsystem's decal pool
+	UPROPERTY(EditAnywhere, Category=Impact)
+	TSoftObjectPtr<UMaterialInterface> DecalMaterial;
+
+	UPROPERTY(EditAnywhere, Category=Impact)
+	FVector DecalSize = FVector(4.0, 8.0, 8.0);
+
+	// How long a pooled decal stays visible, unless it gets recycled first (in seconds)
+	UPROPERTY(EditAnywhere, Category=Impact, meta=(ForceUnits=s))
+	float DecalLifeSpan = 10.0f;
+
+	// Played once per batch at the most significant impact, rather than once per impact
+	UPROPERTY(EditAnywhere, Category=Impact)
+	TSoftObjectPtr<USoundBase> Sound;
+};
+
+/**
+ * Settings for weapon impact batching
+ */
+UCLASS(config=Game, defaultconfig, meta=(DisplayName="Lyra Weapon Impacts"))
+class LYRAGAME_API ULyraWeaponImpactSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Impact cues that are spawned natively from pools. Cue tags without an entry (or whose assets aren't loaded yet)
+	// are executed through the gameplay cue manager as a single multi-impact cue instead.
+	UPROPERTY(config, EditAnywhere, Category=Impacts, meta=(Categories="GameplayCue"))
+	TMap<FGameplayTag, FLyraWeaponImpactEffect> NativeImpactEffects;
+};
+
+/**
+ * ULyraWeaponImpactSubsystem
+ *
+ * Collects the bullet impacts produced during a frame and turns them into effects once, at the end of the frame.
+ * Impacts are grouped per cue tag and instigator, near-duplicates are merged, and the total number of spawns per frame
+ * is capped, keeping the impacts closest to the local view.
+ */
+UCLASS()
+class LYRAGAME_API ULyraWeaponImpactSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Queues a single impact to be spawned at the end of the frame
+	UFUNCTION(BlueprintCallable, Category="Lyra|Weapon")
+	void QueueImpact(AActor* Instigator, FGameplayTag CueTag, const FHitResult& Impact);
+
+	// Queues every hit result in TargetData (e.g., all pellets of a cartridge) to be spawned at the end of the frame
+	UFUNCTION(BlueprintCallable, Category="Lyra|Weapon")
+	void QueueImpactsFromTargetData(AActor* Instigator, FGameplayTag CueTag, const FGameplayAbilityTargetDataHandle& TargetData);
+
+	// Returns every impact carried by a batched impact cue (or the single hit result for a regular cue)
+	UFUNCTION(BlueprintPure, Category="Lyra|Weapon")
+	static TArray<FHitResult> GetImpactsFromCueParameters(const FGameplayCueParameters& Parameters);
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	struct FPendingImpactBatch
+	{
+		TWeakObjectPtr<AActor> Instigator;
+		FGameplayTag CueTag;
+		TArray<FHitResult> Impacts;
+	};
+
+	void FlushImpacts();
+	void CullImpactsBySignificance();
+	bool SpawnNativeImpacts(const FPendingImpactBatch& Batch);
+	void ExecuteBatchedCue(FPendingImpactBatch& Batch);
+	void PlaceDecal(const FLyraWeaponImpactEffect& Effect, UMaterialInterface* DecalMaterial, const FHitResult& Impact);
+	void ExpireDecals();
+
+	TArray<FPendingImpactBatch> PendingBatches;
+
+	// Ring of decal components reused for impacts, the oldest one is recycled once it's full
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDecalComponent>> DecalPool;
+
+	// World time at which each pooled decal should be hidden again (parallel to DecalPool)
+	TArray<double> DecalExpireTimes;
+	int32 NextDecalIndex = 0;
+
+	struct FImpactStats
+	{
+		int64 Queued = 0;
+		int64 Merged = 0;
+		int64 Culled = 0;
+		int64 SpawnedNative = 0;
+		int64 SpawnedThroughCues = 0;
+		int64 CueExecutions = 0;
+	};
+	FImpactStats Stats;
+};
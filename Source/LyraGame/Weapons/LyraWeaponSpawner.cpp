@@ -45,6 +45,9 @@ ALyraWeaponSpawner::ALyraWeaponSpawner()
 	CheckExistingOverlapDelay = 0.25f;
 	bIsWeaponAvailable = true;
 	bReplicates = true;
+
+	// Spawners only replicate when a weapon is picked up or respawns, so keep them dormant in between
+	NetDormancy = DORM_Initial;
 }
 
 // Called when the game starts or when spawned
@@ -129,6 +132,7 @@ void ALyraWeaponSpawner::AttemptPickUpWeapon_Implementation(APawn* Pawn)
 			if (GiveWeapon(WeaponItemDefinition, Pawn))
 			{
 				//Weapon picked up by pawn
+				FlushNetDormancy();
 				bIsWeaponAvailable = false;
 				SetWeaponPickupVisibility(false);
 				PlayPickupEffects();
@@ -157,6 +161,7 @@ void ALyraWeaponSpawner::ResetCoolDown()
 
 	if (GetLocalRole() == ROLE_Authority)
 	{
+		FlushNetDormancy();
 		bIsWeaponAvailable = true;
 		PlayRespawnEffects();
 		SetWeaponPickupVisibility(true);